@@ -0,0 +1,521 @@
+//====================================================
+//     File data
+//====================================================
+/**
+ * @file input.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#pragma once
+#ifndef PYTHON_TO_CPP_INPUT_HPP
+#define PYTHON_TO_CPP_INPUT_HPP
+
+//====================================================
+//     Headers
+//====================================================
+
+// My headers
+#include "print.hpp"
+
+// Standard headers
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Platform headers
+#if defined( _WIN32 )
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+//====================================================
+//     Namespaces
+//====================================================
+namespace ptc
+ {
+  inline namespace detail
+   {
+    //====================================================
+    //     Token parsing
+    //====================================================
+
+    // is_space
+    /**
+     * @brief Function used to check if a char is a whitespace separating two tokens (as std::isspace in the "C" locale).
+     *
+     * @param ch The char.
+     * @return true If the char is a whitespace.
+     * @return false Otherwise.
+     */
+    constexpr bool is_space( char ch ) noexcept
+     {
+      return ch == ' ' || ( ch >= '\t' && ch <= '\r' ); // "\t", "\n", "\v", "\f" and "\r"
+     }
+
+    // parse_number
+    /**
+     * @brief Function used to parse a number at the beginning of a string with std::from_chars, accepting also a leading "+" sign.
+     *
+     * @tparam T The type of the number.
+     * @param first The beginning of the string.
+     * @param last The end of the string.
+     * @param value The parsed number.
+     * @return std::from_chars_result The result of std::from_chars.
+     */
+    template <class T>
+    std::from_chars_result parse_number( const char* first, const char* last, T& value )
+     {
+      if ( last - first > 1 && *first == '+' && first[1] != '-' ) ++first; // std::from_chars does not accept the "+" sign
+      return std::from_chars( first, last, value );
+     }
+
+    // parse_token
+    /**
+     * @brief Function used to convert a token into a value. Numbers are parsed with std::from_chars (a leading "+" is accepted), booleans accept "1", "0", "true", "false", "True" and "False", chars must be a single char and strings are copied.
+     *
+     * @tparam T The type of the value.
+     * @param token The token.
+     * @return T The value.
+     * @throw std::invalid_argument If the token is not a valid representation of a T value.
+     * @throw std::out_of_range If the number does not fit in a T value.
+     */
+    template <class T>
+    T parse_token( std::string_view token )
+     {
+      const auto invalid = [ token ]{ return std::invalid_argument( "ptc: cannot convert \"" + std::string( token ) + "\" to the requested type." ); };
+
+      if constexpr( std::is_same_v<T, std::string> )
+       {
+        return std::string( token );
+       }
+      else if constexpr( std::is_same_v<T, char> )
+       {
+        if ( token.size() != 1 ) throw invalid();
+        return token[0];
+       }
+      else if constexpr( std::is_same_v<T, bool> )
+       {
+        if ( token == "1" || token == "true" || token == "True" ) return true;
+        if ( token == "0" || token == "false" || token == "False" ) return false;
+        throw invalid();
+       }
+      else
+       {
+        static_assert( std::is_arithmetic_v<T>, "ptc::input can read only arithmetic types, chars, booleans and std::string." );
+
+        T value{};
+        const auto [ ptr, error ] = parse_number( token.data(), token.data() + token.size(), value );
+        if ( error == std::errc::result_out_of_range ) throw std::out_of_range( "ptc: \"" + std::string( token ) + "\" is out of the range of the requested type." );
+        if ( error != std::errc() || ptr != token.data() + token.size() ) throw invalid();
+
+        return value;
+       }
+     }
+   }
+
+  //====================================================
+  //     InputReader
+  //====================================================
+
+  // InputReader
+  /**
+   * @brief Class used to read tokens and lines from a file descriptor through a large buffer, with a system call per buffer instead of the per-char work of std::istream. Tokens are returned as views into the buffer, which grows if a single token does not fit in it.
+   *
+   */
+  class InputReader
+   {
+    public:
+
+     //====================================================
+     //     Public constants
+     //====================================================
+     static constexpr std::size_t default_size = 1 << 16;
+     static constexpr std::size_t file_size = 1 << 20;
+
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Constructor from file descriptor
+     /**
+      * @brief Construct a new InputReader object which reads from an open file descriptor, without taking its ownership.
+      *
+      * @param fd The file descriptor.
+      * @param buffer_size The initial size of the buffer.
+      */
+     explicit InputReader( int fd, std::size_t buffer_size = default_size ):
+       fd_( fd ),
+       buffer( buffer_size > 0 ? buffer_size : default_size )
+      {}
+
+     // Constructor from path
+     /**
+      * @brief Construct a new InputReader object which opens and reads a file.
+      *
+      * @param path The path of the file.
+      * @param buffer_size The initial size of the buffer.
+      * @throw std::runtime_error If the file cannot be opened.
+      */
+     explicit InputReader( const std::string& path, std::size_t buffer_size = file_size ):
+       InputReader( open_file( path ), buffer_size )
+      {
+       owned = true;
+      }
+
+     // Destructor
+     /**
+      * @brief Destroy the InputReader object, closing the file descriptor if it is owned.
+      *
+      */
+     ~InputReader()
+      {
+       #if defined( _WIN32 )
+       if ( owned ) ::_close( fd_ );
+       #else
+       if ( owned ) ::close( fd_ );
+       #endif
+      }
+
+     InputReader( const InputReader& ) = delete;
+     InputReader& operator=( const InputReader& ) = delete;
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // nextToken
+     /**
+      * @brief Method used to read the next whitespace-separated token.
+      *
+      * @param token The view in which the token is stored, valid until the next read.
+      * @return true If a token has been read.
+      * @return false If the input is over.
+      */
+     bool nextToken( std::string_view& token )
+      {
+       if ( ! skip_spaces() ) return false;
+
+       // Finding the end of the token, which may continue in the next chunk
+       std::size_t pos = begin;
+       while( true )
+        {
+         while( pos < end && ! is_space( buffer[ pos ] ) ) ++pos;
+         if ( pos < end ) break;
+         const std::size_t length = pos - begin;
+         const bool filled = fill();
+         pos = begin + length;
+         if ( ! filled ) break;
+        }
+
+       token = std::string_view( buffer.data() + begin, pos - begin );
+       begin = pos;
+
+       return true;
+      }
+
+     // readLine
+     /**
+      * @brief Method used to read the rest of the current line, without the line terminator ("\n" or "\r\n").
+      *
+      * @param line The string in which the line is stored.
+      * @return true If a line has been read.
+      * @return false If the input is over.
+      */
+     bool readLine( std::string& line )
+      {
+       std::size_t pos = begin;
+       while( true )
+        {
+         const void* found = std::memchr( buffer.data() + pos, '\n', end - pos );
+         if ( found )
+          {
+           pos = static_cast<std::size_t>( static_cast<const char*>( found ) - buffer.data() );
+           break;
+          }
+         const std::size_t length = end - begin;
+         if ( ! fill() )
+          {
+           if ( begin == end ) return false;
+           pos = end;
+           break;
+          }
+         pos = begin + length;
+        }
+
+       line.assign( buffer.data() + begin, pos - begin );
+       if ( ! line.empty() && line.back() == '\r' ) line.pop_back();
+       begin = pos < end ? pos + 1 : pos;
+
+       return true;
+      }
+
+     // skipLineEnd
+     /**
+      * @brief Method used to consume the blanks and the line terminator which follow the last token, if they are already buffered, so that a following readLine starts from the next line.
+      *
+      */
+     void skipLineEnd()
+      {
+       while( begin < end && ( buffer[ begin ] == ' ' || buffer[ begin ] == '\t' || buffer[ begin ] == '\r' ) ) ++begin;
+       if ( begin < end && buffer[ begin ] == '\n' ) ++begin;
+      }
+
+     // next
+     /**
+      * @brief Method used to read the next token and convert it into a value. Numbers are parsed in place in the buffer, so the token is scanned only once, unless it may continue in the next chunk.
+      *
+      * @tparam T The type of the value.
+      * @param value The value.
+      * @return true If a value has been read.
+      * @return false If the input is over.
+      * @throw std::invalid_argument If the token is not a valid representation of a T value.
+      * @throw std::out_of_range If the number does not fit in a T value.
+      */
+     template <class T>
+     bool next( T& value )
+      {
+       if constexpr( is_number_v<T> )
+        {
+         if ( ! skip_spaces() ) return false;
+         const char* first = buffer.data() + begin;
+         const char* last = buffer.data() + end;
+         const auto [ ptr, error ] = parse_number( first, last, value );
+         if ( error == std::errc() && ( ptr == last ? eof : is_space( *ptr ) ) )
+          {
+           begin += static_cast<std::size_t>( ptr - first );
+           return true;
+          }
+        }
+
+       // Reading the whole token first (also to report errors)
+       std::string_view token;
+       if ( ! nextToken( token ) ) return false;
+       value = parse_token<T>( token );
+
+       return true;
+      }
+
+     // read
+     /**
+      * @brief Method used to read the next token and convert it into a value.
+      *
+      * @tparam T The type of the value.
+      * @return T The value.
+      * @throw std::runtime_error If the input is over.
+      * @throw std::invalid_argument If the token is not a valid representation of a T value.
+      * @throw std::out_of_range If the number does not fit in a T value.
+      */
+     template <class T>
+     T read()
+      {
+       T value{};
+       if ( ! next( value ) ) throw std::runtime_error( "ptc: unexpected end of input." );
+       return value;
+      }
+
+    private:
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // open_file
+     /**
+      * @brief Method used to open a file for reading.
+      *
+      * @param path The path of the file.
+      * @return int The file descriptor.
+      * @throw std::runtime_error If the file cannot be opened.
+      */
+     static int open_file( const std::string& path )
+      {
+       #if defined( _WIN32 )
+       const int fd = ::_open( path.c_str(), _O_RDONLY | _O_BINARY );
+       #else
+       const int fd = ::open( path.c_str(), O_RDONLY );
+       #endif
+       if ( fd < 0 ) throw std::runtime_error( "ptc: cannot open the file \"" + path + "\"." );
+
+       return fd;
+      }
+
+     // skip_spaces
+     /**
+      * @brief Method used to skip the whitespaces before the next token.
+      *
+      * @return true If a token follows.
+      * @return false If the input is over.
+      */
+     bool skip_spaces()
+      {
+       while( true )
+        {
+         while( begin < end && is_space( buffer[ begin ] ) ) ++begin;
+         if ( begin < end ) return true;
+         if ( ! fill() ) return false;
+        }
+      }
+
+     // fill
+     /**
+      * @brief Method used to move the unread data to the beginning of the buffer and to read the next chunk after it. The buffer is doubled if it is full of unread data.
+      *
+      * @return true If new data has been read.
+      * @return false If the input is over.
+      * @throw std::runtime_error If the read fails.
+      */
+     bool fill()
+      {
+       if ( eof ) return false;
+       if ( begin > 0 )
+        {
+         std::memmove( buffer.data(), buffer.data() + begin, end - begin );
+         end -= begin;
+         begin = 0;
+        }
+       if ( end == buffer.size() ) buffer.resize( buffer.size() * 2 );
+
+       while( true )
+        {
+         #if defined( _WIN32 )
+         const auto n = ::_read( fd_, buffer.data() + end, static_cast<unsigned int>( buffer.size() - end ) );
+         #else
+         const auto n = ::read( fd_, buffer.data() + end, buffer.size() - end );
+         if ( n < 0 && errno == EINTR ) continue;
+         #endif
+         if ( n < 0 ) throw std::runtime_error( "ptc: cannot read the input." );
+         if ( n == 0 )
+          {
+           eof = true;
+           return false;
+          }
+         end += static_cast<std::size_t>( n );
+
+         return true;
+        }
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     int fd_;
+     bool owned = false, eof = false;
+     std::vector<char> buffer;
+     std::size_t begin = 0, end = 0;
+   };
+
+  inline namespace detail
+   {
+    // stdin_reader
+    /**
+     * @brief Function used to get the InputReader of the standard input, shared by all the ptc::input calls, and the mutex which protects it.
+     *
+     * @return std::pair<InputReader&, std::mutex&> The reader and its mutex.
+     */
+    inline std::pair<InputReader&, std::mutex&> stdin_reader()
+     {
+      static InputReader reader( 0 );
+      static std::mutex mutex;
+      return { reader, mutex };
+     }
+   }
+
+  //====================================================
+  //     Input functions
+  //====================================================
+
+  // input
+  /**
+   * @brief Function used to read from the standard input, as the Python "input" function. Without template arguments it returns the next line; otherwise it reads one whitespace-separated token per type, which may span several lines, and returns a value (one type) or an std::tuple (several types). The prompt is written to std::cout after the lines queued by ptc::print, and std::cout is flushed if a prompt is given or if it is tied to std::cin. The standard input is read directly, so it must not be read also through std::cin.
+   *
+   * @tparam T The types of the values to be read.
+   * @param prompt The prompt.
+   * @return auto The line, the value or the tuple of values.
+   * @throw std::runtime_error If the input is over.
+   * @throw std::invalid_argument If a token is not a valid representation of its type.
+   * @throw std::out_of_range If a number does not fit in its type.
+   */
+  template <class... T>
+  auto input( std::string_view prompt = {} )
+   {
+    auto [ reader, mutex ] = stdin_reader();
+    std::lock_guard <std::mutex> lock{ mutex };
+
+    if ( ! prompt.empty() )
+     {
+      print.drainAsync();
+      std::cout.write( prompt.data(), static_cast<std::streamsize>( prompt.size() ) );
+      std::cout.flush();
+     }
+    else if ( std::cin.tie() ) std::cin.tie() -> flush();
+
+    if constexpr( sizeof...( T ) == 0 )
+     {
+      std::string line;
+      if ( ! reader.readLine( line ) ) throw std::runtime_error( "ptc: unexpected end of input." );
+      return line;
+     }
+    else if constexpr( sizeof...( T ) == 1 )
+     {
+      auto value = reader.template read<T...>();
+      reader.skipLineEnd();
+      return value;
+     }
+    else
+     {
+      std::tuple<T...> values{ reader.template read<T>()... }; // Braced initializers are evaluated in order
+      reader.skipLineEnd();
+      return values;
+     }
+   }
+
+  // read_all
+  /**
+   * @brief Function used to read all the whitespace-separated tokens of a file (or of the standard input, if the path is empty) and convert them into values.
+   *
+   * @tparam T The type of the values.
+   * @param path The path of the file.
+   * @return std::vector<T> The values.
+   * @throw std::runtime_error If the file cannot be opened or read.
+   * @throw std::invalid_argument If a token is not a valid representation of a T value.
+   * @throw std::out_of_range If a number does not fit in a T value.
+   */
+  template <class T>
+  std::vector<T> read_all( const std::string& path = "" )
+   {
+    std::vector<T> values;
+    T value{};
+    if ( path.empty() )
+     {
+      auto [ reader, mutex ] = stdin_reader();
+      std::lock_guard <std::mutex> lock{ mutex };
+      while( reader.next( value ) ) values.push_back( std::move( value ) );
+     }
+    else
+     {
+      InputReader reader( path );
+      while( reader.next( value ) ) values.push_back( std::move( value ) );
+     }
+
+    return values;
+   }
+ }
+
+#endif
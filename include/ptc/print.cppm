@@ -0,0 +1,28 @@
+//====================================================
+//     File data
+//====================================================
+/**
+ * @file print.cppm
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Global module fragment
+//====================================================
+module;
+
+// Standard and platform headers are parsed here once, when the module interface is built; the list is
+// the one of print.hpp itself, which with PTC_HEADERS_ONLY skips its body
+#define PTC_HEADERS_ONLY
+#include "print.hpp"
+#undef PTC_HEADERS_ONLY
+
+//====================================================
+//     Module interface
+//====================================================
+export module ptc;
+
+#define PTC_EXPORT export
+#include "print.hpp"
@@ -11,9 +11,9 @@
 //====================================================
 //     Preprocessor directives
 //====================================================
-#pragma once
-#ifndef PYTHON_TO_CPP_PRINT_HPP
-#define PYTHON_TO_CPP_PRINT_HPP
+// Headers and feature macros (guarded on their own, so that print.cppm can include only them with PTC_HEADERS_ONLY)
+#ifndef PYTHON_TO_CPP_PRINT_HEADERS
+#define PYTHON_TO_CPP_PRINT_HEADERS
 
 //====================================================
 //     Headers
@@ -29,6 +29,41 @@
 #include <utility>
 #include <locale>
 #include <codecvt>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <ctime>
+#include <cstdint>
+#include <deque>
+#include <condition_variable>
+#include <stdexcept>
+#include <tuple>
+#include <initializer_list>
+#if __has_include( <charconv> )
+#include <charconv>
+#endif
+#if __has_include( <ranges> )
+#include <ranges>
+#endif
+
+// Statistics headers
+#ifdef PTC_ENABLE_STATS
+#include <unordered_map>
+#endif
+
+// Platform headers
+#if defined( _WIN32 )
+#include <process.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/uio.h>
+#include <cerrno>
+#endif
 
 // Extra types headers
 #ifndef PTC_DISABLE_STD_TYPES_PRINTING
@@ -37,7 +72,6 @@
 #include <array>
 #include <stack>
 #include <queue>
-#include <chrono>
 #include <unordered_map>
 #include <typeindex>
 #include <iterator>
@@ -46,12 +80,61 @@
 #include <algorithm>
 #endif
 
+// Vectorized bytes to hexadecimal conversion
+#if defined( __SSSE3__ ) || ( defined( _MSC_VER ) && defined( __AVX__ ) )
+#include <tmmintrin.h>
+#define PTC_HAS_SSSE3
+#endif
+
+// Numbers formatting with std::to_chars (floating-point overloads included)
+#if defined( __cpp_lib_to_chars )
+#define PTC_HAS_TO_CHARS
+#else
+#include <cstdio>
+#include <cstring>
+#endif
+
+// Lazy printing of C++20 ranges and views
+#if defined( __cpp_lib_ranges ) && defined( __cpp_concepts )
+#define PTC_HAS_RANGES
+#endif
+
+// Constant initialization of the global Print objects (needs constexpr std::basic_string, std::vector and std::mutex
+// constructors: the feature macros are not enough, so only the standard libraries known to provide all of them are
+// enabled, i.e. libstdc++ 12 and libc++ 15 or newer, with Clang 15 or newer; define PTC_DISABLE_CONSTINIT to opt out)
+#if defined( __cpp_constinit ) && defined( __cpp_lib_constexpr_string ) && __cpp_lib_constexpr_string >= 201907L && defined( __cpp_lib_constexpr_vector ) && \
+    ( ( defined( _GLIBCXX_RELEASE ) && _GLIBCXX_RELEASE >= 12 ) || ( defined( _LIBCPP_VERSION ) && _LIBCPP_VERSION >= 15000 ) ) && \
+    ( ! defined( __clang__ ) || __clang_major__ >= 15 ) && ! defined( PTC_DISABLE_CONSTINIT )
+#define PTC_HAS_CONSTINIT
+#define PTC_CONSTEXPR constexpr
+#define PTC_CONSTINIT constinit
+#else
+#define PTC_CONSTEXPR
+#define PTC_CONSTINIT
+#endif
+
+// Compile-time literal lines (requires class types as non-type template parameters)
+#if defined( __cpp_nontype_template_args ) && ( __cpp_nontype_template_args >= 201911L )
+#define PTC_HAS_LITERAL_LINES
+#endif
+
+#endif
+
+// Library body
+#if ! defined( PTC_HEADERS_ONLY ) && ! defined( PYTHON_TO_CPP_PRINT_HPP )
+#define PYTHON_TO_CPP_PRINT_HPP
+
+// Module export specifier (set to "export" by print.cppm)
+#ifndef PTC_EXPORT
+#define PTC_EXPORT
+#endif
+
 //====================================================
 //     Namespaces
 //====================================================
 using namespace std::literals::string_literals;
 
-namespace ptc
+PTC_EXPORT namespace ptc
  {
   //====================================================
   //     Enum classes
@@ -71,11 +154,121 @@ namespace ptc
    */
    enum class ANSI { first, generic };
 
+  // time_zone
+  /**
+   * @brief Enum class used to choose the time zone of the timestamp prefix.
+   * 
+   */
+   enum class time_zone { local, utc };
+
+  // overflow
+  /**
+   * @brief Enum class used to choose what asynchronous printing does when its queue is full: wait for free space, drop the new line, drop the oldest queued line or append the new line to a file.
+   * 
+   */
+   enum class overflow { block, drop_newest, overwrite_oldest, spill };
+
+  // layout
+  /**
+   * @brief Enum class used to choose how ptc::nested prints a nested range: on a single line or with each innermost range on its own line and all the elements aligned.
+   * 
+   */
+   enum class layout { compact, aligned };
+
+  // tty
+  /**
+   * @brief Enum class used to choose if a Print object treats its streams as terminals: detected for each stream, always or never. Lines written to a stream which is not a terminal are stripped of ANSI escape sequences.
+   * 
+   */
+   enum class tty { automatic, always, never };
+
+  //====================================================
+  //     Structs
+  //====================================================
+
+  // FlushPolicy
+  /**
+   * @brief Struct used to define when a Print object flushes its streams, if it is not flushing each line. Disabled conditions are zero (or false).
+   * 
+   */
+  struct FlushPolicy
+   {
+    std::size_t lines = 0;                          ///< Flush every N lines.
+    std::size_t bytes = 0;                          ///< Flush once N bytes have been written since the last flush.
+    std::chrono::milliseconds interval{ 0 };        ///< Flush at the first line written at least this time after the last flush.
+    bool on_error = false;                          ///< Flush immediately lines written to std::cerr or std::clog.
+   };
+
+  // AsyncPolicy
+  /**
+   * @brief Struct used to configure the asynchronous printing of a Print object.
+   * 
+   */
+  struct AsyncPolicy
+   {
+    std::size_t capacity = 0;                       ///< Maximum number of queued lines (0 disables asynchronous printing).
+    overflow on_overflow = overflow::block;         ///< What to do when the queue is full.
+    std::string spill_path;                         ///< File to which lines are appended with overflow::spill.
+    bool summary = true;                            ///< Write a "N lines dropped" line once lines can be written again.
+   };
+
+  // AsyncStats
+  /**
+   * @brief Struct used to store the counters of the asynchronous printing of a Print object.
+   * 
+   */
+  struct AsyncStats
+   {
+    std::uint64_t queued = 0;                       ///< Lines added to the queue.
+    std::uint64_t written = 0;                      ///< Lines written by the background thread.
+    std::uint64_t dropped = 0;                      ///< New lines dropped (overflow::drop_newest).
+    std::uint64_t overwritten = 0;                  ///< Queued lines dropped by newer ones (overflow::overwrite_oldest).
+    std::uint64_t spilled = 0;                      ///< Lines appended to the spill file (overflow::spill).
+    std::uint64_t blocked = 0;                      ///< Calls which waited for free space (overflow::block).
+   };
+
+  // PrintEvent
+  /**
+   * @brief Struct used to describe a printed line to the pre-write and post-write hooks of a Print object. Times are measured with std::chrono::steady_clock; "lock_wait" and "writing" are zero in pre-write hooks.
+   * 
+   * @tparam T_str The char type of the target stream.
+   */
+  template <class T_str>
+  struct PrintEvent
+   {
+    std::basic_ostream<T_str>* stream = nullptr;    ///< The stream the line is written to.
+    std::size_t bytes = 0;                          ///< The size of the formatted line in bytes.
+    std::chrono::steady_clock::time_point start;    ///< The time at which the print call started.
+    std::chrono::nanoseconds formatting{ 0 };       ///< Time spent formatting the arguments.
+    std::chrono::nanoseconds lock_wait{ 0 };        ///< Time spent waiting for the Print mutex.
+    std::chrono::nanoseconds writing{ 0 };          ///< Time spent writing (and flushing) the line.
+   };
+
+  #ifdef PTC_ENABLE_STATS
+
+  // PrintStats
+  /**
+   * @brief Struct used to store a snapshot of the runtime statistics of a Print object. Times are measured with std::chrono::steady_clock.
+   * 
+   */
+  struct PrintStats
+   {
+    std::uint64_t calls = 0;                        ///< Number of print calls.
+    std::uint64_t bytes = 0;                        ///< Number of bytes written to the output streams.
+    std::uint64_t flushes = 0;                      ///< Number of stream flushes.
+    std::uint64_t ansi_resets = 0;                  ///< Number of automatic ANSI reset sequences emitted.
+    std::chrono::nanoseconds lock_wait{ 0 };        ///< Time spent waiting for the Print mutex.
+    std::chrono::nanoseconds formatting{ 0 };       ///< Time spent formatting the arguments.
+    std::chrono::nanoseconds writing{ 0 };          ///< Time spent writing (and flushing) the formatted lines.
+   };
+
+  #endif
+
   //====================================================
   //     Helper tools
   //====================================================
 
-  namespace
+  inline namespace detail
    {
     // StringConverter
     /**
@@ -121,754 +314,5070 @@ namespace ptc
         return StringConverter<CharT>( "" );
        }
      }
-  
-    #ifndef PTC_DISABLE_STD_TYPES_PRINTING
-  
-    // is_streamable
+
+    // is_tty
     /**
-     * @brief Struct used to define a specific type trait for operator << overload for container printing.
+     * @brief Function used to check if a file descriptor refers to a terminal.
      * 
-     * @tparam T Template type of the type trait.
+     * @param fd The file descriptor.
+     * @return true If the file descriptor is a terminal.
+     * @return false Otherwise.
      */
-    template <class T, class T_str>
-    struct is_streamable 
+    inline bool is_tty( int fd )
      {
-      static std::false_type test( ... );
-        
-      template<class U>
-      static auto test( const U& u ) -> decltype( std::declval <std::basic_ostream<T_str>&>() << u, std::true_type{} );
-    
-      static constexpr bool value = decltype( test( std::declval <T>() ) )::value;
+      #if defined( _WIN32 )
+      return _isatty( fd ) != 0;
+      #else
+      return isatty( fd ) != 0;
+      #endif
+     }
+
+    // LineBuffer
+    /**
+     * @brief Stream buffer used to format a whole line in memory before it is written to its output stream. Its storage is kept between lines, in order to avoid reallocations.
+     * 
+     * @tparam T_str The char type of the buffer.
+     */
+    template <class T_str>
+    class LineBuffer: public std::basic_streambuf<T_str>
+     {
+      public:
+
+       using int_type = typename std::basic_streambuf<T_str>::int_type;
+       using traits_type = typename std::basic_streambuf<T_str>::traits_type;
+
+       const T_str* data() const { return line.data(); }
+       T_str* data() { return line.data(); }
+       std::size_t size() const { return line.size(); }
+       void clear() { line.clear(); }
+       void resize( std::size_t size ) { line.resize( size ); }
+
+      protected:
+
+       int_type overflow( int_type c ) override
+        {
+         if ( ! traits_type::eq_int_type( c, traits_type::eof() ) ) line.push_back( traits_type::to_char_type( c ) );
+         return traits_type::not_eof( c );
+        }
+
+       std::streamsize xsputn( const T_str* s, std::streamsize n ) override
+        {
+         line.append( s, static_cast<std::size_t>( n ) );
+         return n;
+        }
+
+      private:
+
+       std::basic_string<T_str> line;
      };
-    
-    template<class T, class T_str>
-    inline constexpr bool is_streamable_v = is_streamable<T, T_str>::value;
-  
-    // Helper function for container adaptors printing
-    /**std::string
-     * @brief Helper function for container adaptors printing.
+
+    // LineCut
+    /**
+     * @brief Struct used to describe a string which is not copied into a LineBuffer, but referenced in place at a given position of the line.
+     * 
+     * @tparam T_str The char type of the string.
+     */
+    template <class T_str>
+    struct LineCut
+     {
+      std::size_t pos;
+      std::basic_string_view<T_str> text;
+     };
+
+    // LineStream
+    /**
+     * @brief Output stream bound to a LineBuffer object. The cuts and pieces are used only when a line is gathered (see FastStreambuf::writeGathered), while "prefix" is the size of the line prefixes at the beginning of the buffer.
      * 
-     * @tparam Container The modified type of the container to be printed.
      * @tparam T_str The char type of the stream.
-     * @param os The stream to which the container is printed to.
-     * @param container The container to be printed.
      */
-    template <class Container, class T_str>
-    inline void print_adaptor( std::basic_ostream<T_str>& os, const Container& container )
+    template <class T_str>
+    struct LineStream
      {
-      typename Container::const_iterator beg = container.begin();
-      std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
-      
-      while( beg != container.end() )
-       {
-        os << separator << *beg++;
-        separator = StringConverter<T_str>( ", "s );
-       }
-     }
-    
-    // container_mod overload for std::stack hacked printing
+      LineBuffer<T_str> buffer;
+      std::basic_ostream<T_str> os{ &buffer };
+      std::vector<LineCut<T_str>> cuts;
+      std::vector<std::basic_string_view<T_str>> pieces;
+      std::size_t prefix = 0;
+     };
+
+    // line_stream
     /**
-     * @brief Overload used to create a modified stack object in order to be successfully printed.
+     * @brief Function used to get the thread-local LineStream object, in order to format lines without any locking.
      * 
-     * @tparam Type The type of the stack elements..
-     * @tparam Container The type of the container.
-     * @param stack The stack to be modified.
-     * @return const Container& The modified stack.
+     * @tparam T_str The char type of the stream.
+     * @return LineStream<T_str>& The LineStream of the calling thread.
      */
-    template <class Type, class Container>
-    const Container& container_mod( const std::stack<Type, Container>& stack )
+    template <class T_str>
+    inline LineStream<T_str>& line_stream()
      {
-      struct HackedStack : private std::stack<Type, Container>
-       {
-        static const Container& container( const std::stack<Type, Container>& stack )
-         {
-          return stack.*&HackedStack::c;
-         }
-       };
-    
-      return HackedStack::container( stack );
+      thread_local LineStream<T_str> line;
+      return line;
      }
-  
-    // container_mod overload for std::priority_queue hacked printing
+
+    // fnv1a
     /**
-     * @brief Overload used to create a modified priority_queue object in order to be successfully printed.
+     * @brief Function used to compute the 64-bit FNV-1a hash of a string, byte by byte.
      * 
-     * @tparam Type The type of the priority_queue elements..
-     * @tparam Container The type of the container.
-     * @param priority_queue The priority_queue to be modified.
-     * @return const Container& The modified priority_queue.
+     * @tparam T_str The char type of the string.
+     * @param data The string.
+     * @param size The size of the string.
+     * @return std::uint64_t The hash.
      */
-    template < class Type, class Container >
-    const Container& container_mod( const std::priority_queue<Type, Container>& priority_queue )
+    template <class T_str>
+    inline std::uint64_t fnv1a( const T_str* data, std::size_t size )
      {
-      struct HackedQueue : private std::priority_queue<Type, Container>
+      const unsigned char* bytes = reinterpret_cast<const unsigned char*>( data );
+      std::uint64_t hash = 14695981039346656037ull;
+      for( std::size_t i = 0; i < size * sizeof( T_str ); ++i )
        {
-        static const Container& container( const std::priority_queue<Type, Container>& priority_queue )
-         {
-          return priority_queue.*&HackedQueue::c;
-         }
-       };
-  
-      return HackedQueue::container( priority_queue );
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+       }
+      return hash;
      }
-  
-    //====================================================
-    //     Operator << overloads for stdlib types
-    //====================================================
-  
-    #if defined( __GNUC__ ) && ( __GNUC___ <= 9 )
-  
-    // Overload for std::nullptr_t
+
+    // AsyncState
     /**
-     * @brief Operator << overload for std::nullptr_t printing.
+     * @brief Struct used to store the queue and the background thread of an asynchronous Print object.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @param os The type of the output stream.
-     * @return std::basic_ostream<T_str>& The stream to which the object is printed to.
+     * @tparam T_str The char type of the lines.
      */
     template <class T_str>
-    inline std::basic_ostream<T_str>& operator << ( std::basic_ostream<T_str>& os, std::nullptr_t )
+    struct AsyncState
      {
-      os << "nullptr";
-      return os; 
-     }
-  
-    #endif
-  
-    // Overload for std::complex
+      struct Item
+       {
+        std::basic_ostream<T_str>* os;
+        std::basic_string<T_str> line;
+        std::size_t prefix;
+        std::uint64_t lost_before;
+       };
+
+      AsyncPolicy policy;
+      std::mutex mutex;
+      std::condition_variable not_empty, not_full, idle;
+      std::deque<Item> queue;
+      std::ofstream spill;
+      AsyncStats stats;
+      std::uint64_t unreported = 0;
+      std::basic_ostream<T_str>* last = nullptr;
+      bool stop = false, busy = false;
+      std::thread worker;
+     };
+
+    // is_standard_stream
     /**
-     * @brief Operator << overload for std::complex printing.
+     * @brief Function used to check if a stream is one of the standard output streams.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T_cmplx The type of the real and imaginary part complex number to be printed.
-     * @param os The type of the output stream.
-     * @param number The number to be printed.
-     * @return std::basic_ostream<T_str>& The stream to which the number is printed to.
+     * @param os The stream.
+     * @return true If the stream is std::cout, std::cerr, std::clog or one of their wide versions.
+     * @return false Otherwise.
      */
-    template <class T_str, class T_cmplx>
-    inline std::basic_ostream<T_str>& operator << ( std::basic_ostream<T_str>& os, const std::complex<T_cmplx>& number )
+    inline bool is_standard_stream( const void* os )
      {
-      os << number.real() << '+' << number.imag() << 'j';
-  
-      return os; 
+      return os == &std::cout || os == &std::cerr || os == &std::clog || os == &std::wcout || os == &std::wcerr || os == &std::wclog;
      }
-  
-    // Helper overload for std::vector and std::map
+
+    // ErasedValue
     /**
-     * @brief Helper overload to print test containers (std::vector and std::map).
+     * @brief Union used to store the address of a type-erased argument.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T First template type of the std::pair variable.
-     * @tparam U Second template type of the std::pair variable.
-     * @param os The stream to which the overload prints.
-     * @param p The std::pair object.
-     * @return std::basic_ostream<T_str>& The stream to which the container is printed to.
      */
-    template <class T_str, class T, class U>
-    inline std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const std::pair <T, U>& p ) 
+    union ErasedValue
      {
-      os << '[' << p.first << ", " << p.second << ']';
-  
-      return os;
-     } 
-  
-    // Overload for all containers printing
+      void* object;
+      void ( *function )();
+     };
+
+    // ErasedArg
     /**
-     * @brief Overload for all containers printing. Containers which already has an operator << overload will be ignored.
+     * @brief Struct used to store a type-erased argument of a print call, together with the function which writes it to a stream.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam ContainerType The container type (ex std::vector, std::map etc...)
-     * @tparam ValueType The value type of the container.
-     * @tparam Args The arguments of the container.
-     * @param os The stream to which the output is printed.
-     * @param container The container to be printed.
-     * @return std::basic_ostream<T_str>& The stream to which the container is printed to.
+     * @tparam T_str The char type of the stream.
      */
-    template <template <typename, typename...> class ContainerType, typename ValueType, typename... Args, class T_str>
-    std::enable_if_t< ! is_streamable_v <ContainerType <ValueType, Args...>, T_str>, std::basic_ostream<T_str>&>
+    template <class T_str>
+    struct ErasedArg
+     {
+      ErasedValue value;
+      void ( *write )( std::basic_ostream<T_str>&, const ErasedValue& );
+      bool escape;
+      const T_str* data = nullptr;
+      std::size_t size = 0;
+     };
+
+    // ErasedLine
+    /**
+     * @brief Struct used to describe a print call with type-erased arguments.
+     * 
+     * @tparam T_str The char type of the stream.
+     */
+    template <class T_str>
+    struct ErasedLine
+     {
+      const ErasedArg<T_str>* args;
+      std::size_t count;
+      bool first_escape;
+      bool prefixed;
+     };
+
+    // is_char_string
+    /**
+     * @brief Trait used to check if a type is a C string (an array of chars or a pointer to chars) which can be written to a stream of T_str chars: its char type must be char or T_str.
+     * 
+     * @tparam T_str The char type of the stream.
+     * @tparam T The type.
+     */
+    template <class T_str, class T, class T_decay = std::decay_t<T>>
+    struct is_char_string: std::false_type {};
+
+    template <class T_str, class T, class T_char>
+    struct is_char_string<T_str, T, T_char*>: std::bool_constant<
+      std::is_same_v<std::remove_cv_t<T_char>, char> || std::is_same_v<std::remove_cv_t<T_char>, T_str>> {};
+
+    template <class T_str, class T>
+    inline constexpr bool is_char_string_v = is_char_string<T_str, T>::value;
+
+    // TimestampCache
+    /**
+     * @brief Struct used to store the last rendered timestamp of a thread. The date and time are rendered once per second, while the sub-second digits are rewritten in place at each call.
+     * 
+     * @tparam T_str The char type of the timestamp.
+     */
+    template <class T_str>
+    struct TimestampCache
+     {
+      std::size_t id = 0;
+      std::time_t second = 0;
+      std::size_t digits_pos = 0, digits = 0;
+      std::basic_string<T_str> text;
+     };
+
+    // timestamp_id
+    /**
+     * @brief Function used to generate a unique id for each timestamp configuration, in order to invalidate the thread-local caches when the configuration changes.
+     * 
+     * @return std::size_t The new id.
+     */
+    inline std::size_t timestamp_id()
+     {
+      static std::atomic<std::size_t> counter{ 0 };
+      return counter.fetch_add( 1, std::memory_order_relaxed ) + 1;
+     }
+
+    // config_id
+    /**
+     * @brief Function used to generate a unique id for each configuration of the Print objects, in order to invalidate the thread-local snapshots when a setter changes it.
+     * 
+     * @return std::uint64_t The new id.
+     */
+    inline std::uint64_t config_id()
+     {
+      static std::atomic<std::uint64_t> counter{ 0 };
+      return counter.fetch_add( 1, std::memory_order_relaxed ) + 1;
+     }
+
+    // strftime_append
+    /**
+     * @brief Function used to render a strftime format and append it to a string. Characters are widened one by one, therefore only ASCII output is supported by non-char strings.
+     * 
+     * @tparam T_str The char type of the string.
+     * @param out The string to which the result is appended.
+     * @param format The strftime format.
+     * @param tm The broken-down time.
+     */
+    template <class T_str>
+    inline void strftime_append( std::basic_string<T_str>& out, const std::string& format, const std::tm& tm )
+     {
+      if ( format.empty() ) return;
+
+      std::vector<char> buf( 64 + format.size() * 4 );
+      std::size_t size = 0;
+      for( int i = 0; i < 4 && ( size = std::strftime( buf.data(), buf.size(), format.c_str(), &tm ) ) == 0; ++i ) buf.resize( buf.size() * 4 );
+      for( std::size_t i = 0; i < size; ++i ) out.push_back( static_cast<T_str>( static_cast<unsigned char>( buf[i] ) ) );
+     }
+
+    // render_timestamp
+    /**
+     * @brief Function used to get the current timestamp, using the thread-local cache.
+     * 
+     * @tparam T_str The char type of the timestamp.
+     * @param id The id of the timestamp configuration.
+     * @param head The strftime format before the sub-second digits.
+     * @param tail The strftime format after the sub-second digits.
+     * @param digits The number of sub-second digits (0 if disabled).
+     * @param zone The time zone.
+     * @return const std::basic_string<T_str>& The timestamp.
+     */
+    template <class T_str>
+    inline const std::basic_string<T_str>& render_timestamp( std::size_t id, const std::string& head, const std::string& tail, std::size_t digits, time_zone zone )
+     {
+      thread_local TimestampCache<T_str> cache;
+
+      const auto now = std::chrono::system_clock::now();
+      const std::time_t time = std::chrono::system_clock::to_time_t( std::chrono::floor<std::chrono::seconds>( now ) );
+
+      // Rendering the date and time once per second
+      if ( cache.id != id || cache.second != time )
+       {
+        std::tm tm{};
+        #if defined( _WIN32 )
+        if ( zone == time_zone::utc ) gmtime_s( &tm, &time );
+        else localtime_s( &tm, &time );
+        #else
+        if ( zone == time_zone::utc ) gmtime_r( &time, &tm );
+        else localtime_r( &time, &tm );
+        #endif
+
+        cache.text.clear();
+        strftime_append( cache.text, head, tm );
+        cache.digits_pos = cache.text.size();
+        cache.digits = digits;
+        cache.text.append( digits, static_cast<T_str>( '0' ) );
+        strftime_append( cache.text, tail, tm );
+        cache.id = id;
+        cache.second = time;
+       }
+
+      // Rewriting the sub-second digits
+      if ( cache.digits > 0 )
+       {
+        auto fraction = std::chrono::duration_cast<std::chrono::nanoseconds>( now - std::chrono::system_clock::from_time_t( time ) ).count();
+        for( std::size_t i = cache.digits; i < 9; ++i ) fraction /= 10;
+        for( std::size_t i = cache.digits; i > 0; --i, fraction /= 10 ) cache.text[ cache.digits_pos + i - 1 ] = static_cast<T_str>( '0' + fraction % 10 );
+       }
+
+      return cache.text;
+     }
+
+    // ThreadName
+    /**
+     * @brief Struct used to store the name of a thread. The generation is increased at each change, in order to invalidate the preformatted thread prefixes.
+     * 
+     */
+    struct ThreadName
+     {
+      std::string name;
+      std::size_t generation = 1;
+     };
+
+    // thread_name
+    /**
+     * @brief Function used to get the ThreadName object of the calling thread.
+     * 
+     * @return ThreadName& The name of the calling thread.
+     * @note A template only because GCC 12 crashes exporting a non-template inline function with a thread_local object of class type.
+     */
+    template <class = void>
+    inline ThreadName& thread_name()
+     {
+      thread_local ThreadName name;
+      return name;
+     }
+
+    // thread_prefix
+    /**
+     * @brief Function used to get the preformatted prefix of the calling thread: its name if set, its id otherwise. The prefix is formatted once per thread and name change.
+     * 
+     * @tparam T_str The char type of the prefix.
+     * @return const std::basic_string<T_str>& The thread prefix.
+     */
+    template <class T_str>
+    inline const std::basic_string<T_str>& thread_prefix()
+     {
+      thread_local std::size_t generation = 0;
+      thread_local std::basic_string<T_str> text;
+
+      const ThreadName& current = thread_name();
+      if ( generation != current.generation )
+       {
+        std::string name = current.name;
+        if ( name.empty() )
+         {
+          std::ostringstream oss;
+          oss << std::this_thread::get_id();
+          name = oss.str();
+         }
+        text.clear();
+        for( const char ch: name ) text.push_back( static_cast<T_str>( static_cast<unsigned char>( ch ) ) );
+        generation = current.generation;
+       }
+
+      return text;
+     }
+
+    #ifdef PTC_HAS_LITERAL_LINES
+
+    // fixed_string
+    /**
+     * @brief Struct used to pass string literals as template arguments.
+     * 
+     * @tparam N The size of the literal, including the null terminator.
+     */
+    template <std::size_t N>
+    struct fixed_string
+     {
+      char data[N]{};
+
+      constexpr fixed_string( const char ( &str )[N] )
+       {
+        for( std::size_t i = 0; i < N; ++i ) data[i] = str[i];
+       }
+
+      constexpr std::size_t size() const 
+       { 
+        return N - 1; 
+       }
+
+      constexpr bool has_escape() const
+       {
+        for( std::size_t i = 0; i < size(); ++i ) if ( data[i] == '\033' ) return true;
+        return false;
+       }
+     };
+
+    // LiteralLine
+    /**
+     * @brief Struct used to store a line built at compile-time.
+     * 
+     * @tparam N The size of the line.
+     */
+    template <std::size_t N>
+    struct LiteralLine
+     {
+      char data[N + 1]{};
+      std::size_t size = N;
+     };
+
+    // literal_line
+    /**
+     * @brief Function used to build at compile-time the line written by a Print object with the default configuration (" " sep, "\n" end and no pattern). It follows the same rules of the runtime path: no sep after a leading ANSI escape sequence and a final reset if an argument contains one.
+     * 
+     * @tparam First The first literal.
+     * @tparam Args All the other literals.
+     * @return constexpr auto The line.
+     */
+    template <fixed_string First, fixed_string... Args>
+    constexpr auto literal_line()
+     {
+      constexpr bool first_escape = First.size() < 7 && First.size() > 0 && First.data[0] == '\033';
+      constexpr bool reset = First.has_escape() || ( Args.has_escape() || ... );
+      constexpr std::size_t size = First.size() + ( ( Args.size() + 1 ) + ... + 0 ) + 1 + ( reset ? 4 : 0 );
+
+      LiteralLine<size> line;
+      std::size_t pos = 0;
+      auto append = [ & ]( const char* str, std::size_t length ){ for( std::size_t i = 0; i < length; ++i ) line.data[pos++] = str[i]; };
+      append( First.data, First.size() );
+      if constexpr( first_escape ) ( ( append( Args.data, Args.size() ), append( " ", 1 ) ), ... );
+      else ( ( append( " ", 1 ), append( Args.data, Args.size() ) ), ... );
+      append( "\n", 1 );
+      if constexpr( reset ) append( "\033[0m", 4 );
+
+      return line;
+     }
+
+    #endif
+
+    #ifdef PTC_ENABLE_STATS
+
+    // StatsCounters
+    /**
+     * @brief Struct used to store the statistics counters of a single thread. Each counter is written only by its owning thread, so relaxed loads and stores are enough and no read-modify-write is needed.
+     * 
+     */
+    struct StatsCounters
+     {
+      std::atomic<std::uint64_t> calls{ 0 }, bytes{ 0 }, flushes{ 0 }, ansi_resets{ 0 };
+      std::atomic<std::uint64_t> lock_wait{ 0 }, formatting{ 0 }, writing{ 0 };
+
+      static void add( std::atomic<std::uint64_t>& counter, std::uint64_t value )
+       {
+        counter.store( counter.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+       }
+     };
+
+    #endif
+  
+    #ifndef PTC_DISABLE_STD_TYPES_PRINTING
+  
+    // is_streamable
+    /**
+     * @brief Struct used to define a specific type trait for operator << overload for container printing.
+     * 
+     * @tparam T Template type of the type trait.
+     */
+    template <class T, class T_str>
+    struct is_streamable 
+     {
+      static std::false_type test( ... );
+        
+      template<class U>
+      static auto test( const U& u ) -> decltype( std::declval <std::basic_ostream<T_str>&>() << u, std::true_type{} );
+    
+      static constexpr bool value = decltype( test( std::declval <T>() ) )::value;
+     };
+    
+    template<class T, class T_str>
+    inline constexpr bool is_streamable_v = is_streamable<T, T_str>::value;
+  
+    // Helper function for container adaptors printing
+    /**std::string
+     * @brief Helper function for container adaptors printing.
+     * 
+     * @tparam Container The modified type of the container to be printed.
+     * @tparam T_str The char type of the stream.
+     * @param os The stream to which the container is printed to.
+     * @param container The container to be printed.
+     */
+    template <class Container, class T_str>
+    inline void print_adaptor( std::basic_ostream<T_str>& os, const Container& container )
+     {
+      typename Container::const_iterator beg = container.begin();
+      std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
+      
+      while( beg != container.end() )
+       {
+        os << separator << *beg++;
+        separator = StringConverter<T_str>( ", "s );
+       }
+     }
+    
+    // container_mod overload for std::stack hacked printing
+    /**
+     * @brief Overload used to create a modified stack object in order to be successfully printed.
+     * 
+     * @tparam Type The type of the stack elements..
+     * @tparam Container The type of the container.
+     * @param stack The stack to be modified.
+     * @return const Container& The modified stack.
+     */
+    template <class Type, class Container>
+    const Container& container_mod( const std::stack<Type, Container>& stack )
+     {
+      struct HackedStack : private std::stack<Type, Container>
+       {
+        static const Container& container( const std::stack<Type, Container>& stack )
+         {
+          return stack.*&HackedStack::c;
+         }
+       };
+    
+      return HackedStack::container( stack );
+     }
+  
+    // container_mod overload for std::priority_queue hacked printing
+    /**
+     * @brief Overload used to create a modified priority_queue object in order to be successfully printed.
+     * 
+     * @tparam Type The type of the priority_queue elements..
+     * @tparam Container The type of the container.
+     * @param priority_queue The priority_queue to be modified.
+     * @return const Container& The modified priority_queue.
+     */
+    template < class Type, class Container >
+    const Container& container_mod( const std::priority_queue<Type, Container>& priority_queue )
+     {
+      struct HackedQueue : private std::priority_queue<Type, Container>
+       {
+        static const Container& container( const std::priority_queue<Type, Container>& priority_queue )
+         {
+          return priority_queue.*&HackedQueue::c;
+         }
+       };
+  
+      return HackedQueue::container( priority_queue );
+     }
+  
+    //====================================================
+    //     Operator << overloads for stdlib types
+    //====================================================
+  
+    #if defined( __GNUC__ ) && ( __GNUC___ <= 9 )
+  
+    // Overload for std::nullptr_t
+    /**
+     * @brief Operator << overload for std::nullptr_t printing.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @param os The type of the output stream.
+     * @return std::basic_ostream<T_str>& The stream to which the object is printed to.
+     */
+    template <class T_str>
+    inline std::basic_ostream<T_str>& operator << ( std::basic_ostream<T_str>& os, std::nullptr_t )
+     {
+      os << "nullptr";
+      return os; 
+     }
+  
+    #endif
+  
+    // Overload for std::complex
+    /**
+     * @brief Operator << overload for std::complex printing.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T_cmplx The type of the real and imaginary part complex number to be printed.
+     * @param os The type of the output stream.
+     * @param number The number to be printed.
+     * @return std::basic_ostream<T_str>& The stream to which the number is printed to.
+     */
+    template <class T_str, class T_cmplx>
+    inline std::basic_ostream<T_str>& operator << ( std::basic_ostream<T_str>& os, const std::complex<T_cmplx>& number )
+     {
+      os << number.real() << '+' << number.imag() << 'j';
+  
+      return os; 
+     }
+  
+    // Helper overload for std::vector and std::map
+    /**
+     * @brief Helper overload to print test containers (std::vector and std::map).
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T First template type of the std::pair variable.
+     * @tparam U Second template type of the std::pair variable.
+     * @param os The stream to which the overload prints.
+     * @param p The std::pair object.
+     * @return std::basic_ostream<T_str>& The stream to which the container is printed to.
+     */
+    template <class T_str, class T, class U>
+    inline std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const std::pair <T, U>& p ) 
+     {
+      os << '[' << p.first << ", " << p.second << ']';
+  
+      return os;
+     } 
+  
+    // is_lazy_range_v
+    /**
+     * @brief Trait used to check if a type is a range view (e.g. std::span or the result of std::views::filter), which is printed lazily instead of through the containers overload. String views are excluded.
+     * 
+     * @tparam T The type.
+     */
+    #ifdef PTC_HAS_RANGES
+    template <class T>
+    concept lazy_range = std::ranges::view<T> && std::ranges::input_range<T> && ! std::same_as<T, std::basic_string_view<std::ranges::range_value_t<T>>>;
+
+    template <class T>
+    inline constexpr bool is_lazy_range_v = lazy_range<T>;
+    #else
+    template <class T>
+    inline constexpr bool is_lazy_range_v = false;
+    #endif
+
+    #ifdef PTC_HAS_RANGES
+
+    // Overload for ranges views printing (defined in the ranges printing section)
+    template <class T_str, class Range>
+    requires is_lazy_range_v<std::remove_cvref_t<Range>> && std::ranges::input_range<Range>
+    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, Range&& range );
+
+    #endif
+
+    // Overload for all containers printing
+    /**
+     * @brief Overload for all containers printing. Containers which already has an operator << overload will be ignored.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam ContainerType The container type (ex std::vector, std::map etc...)
+     * @tparam ValueType The value type of the container.
+     * @tparam Args The arguments of the container.
+     * @param os The stream to which the output is printed.
+     * @param container The container to be printed.
+     * @return std::basic_ostream<T_str>& The stream to which the container is printed to.
+     */
+    template <template <typename, typename...> class ContainerType, typename ValueType, typename... Args, class T_str>
+    std::enable_if_t< ! is_streamable_v <ContainerType <ValueType, Args...>, T_str> && ! is_lazy_range_v<ContainerType <ValueType, Args...>>, std::basic_ostream<T_str>&>
     operator <<( std::basic_ostream<T_str>& os, const ContainerType<ValueType, Args...>& container ) 
      {
-      static bool constexpr is_stack = std::is_same_v <ContainerType<ValueType, Args...>, std::stack<ValueType>>;
-      static bool constexpr is_pqueue = std::is_same_v <ContainerType<ValueType, Args...>, std::priority_queue<ValueType>>;
-      
-      os << '[';
-      if constexpr ( ! is_stack && ! is_pqueue )
+      static bool constexpr is_stack = std::is_same_v <ContainerType<ValueType, Args...>, std::stack<ValueType>>;
+      static bool constexpr is_pqueue = std::is_same_v <ContainerType<ValueType, Args...>, std::priority_queue<ValueType>>;
+      
+      os << '[';
+      if constexpr ( ! is_stack && ! is_pqueue )
+       {
+        std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
+        for ( const auto& elem: container )
+         {
+          os << separator;
+          os << elem;
+          separator = StringConverter<T_str>( ", "s );
+         }
+       }
+      else
+       {
+        print_adaptor( os, container_mod( container ) );
+       }
+      os << ']';
+  
+      return os;
+     }
+  
+    // Overload for std::array printing
+    /**
+     * @brief Overload for std::array printing.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T The type of the array.
+     * @tparam T_no The number of elements of the array.
+     * @param os The stream to which the output is printed.
+     * @param container The array to be printed.
+     * @return std::basic_ostream<T_str>& The stream to which the array is printed to.
+     */
+    template <class T_str, class T, size_t T_no>
+    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const std::array<T, T_no>& container ) 
+     {
+      std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
+  
+      os << '[';
+      std::copy
+       (
+        std::begin( container ),
+        std::prev( container.end() ),
+        std::ostream_iterator <T> { os, ", " }
+       );
+      os << container.back();
+      os << ']';
+  
+      return os;
+     }
+  
+    // Overload for C arrays
+    /**
+     * @brief Overload for C arrays printing.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T1 The type of the array.
+     * @tparam arrSize The size of the array.
+     * @tparam std::enable_if_t< ! std::is_same <T1,char>::value> Enable if it is not const char*.
+     * @param os The stream to which the array is printed to.
+     * @return std::basic_ostream<T_str>& The stream to which the array is printed to.
+     */
+    template <class T_str, class T1, size_t arrSize, 
+    typename = std::enable_if_t< ! std::is_same <T1,char>::value>>
+    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const T1( & arr )[ arrSize ] )
+     {
+      os << '[';
+      if ( arrSize )
+       {
+        std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
+        for ( const auto& elem: arr )
+         {
+          os << separator;
+          os << elem;
+          separator = StringConverter<T_str>( ", "s );
+         }
+       }
+      os << ']';
+  
+      return os;
+     }
+  
+    // Overload for std::chrono::duration objects
+    /**
+     * @brief Operator << overload for std::chrono::duration objects printing.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T_time The order of magnitude of the time object.
+     * @tparam int_type The int type of the time object.
+     * @param os The stream to which the time object is printed to.
+     * @param val The time object.
+     * @return std::basic_ostream<T_str>& The stream to which the time object is printed to.
+     */
+    template <class T_str, class T_time, class int_type>
+    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const std::chrono::duration<int_type, T_time>& val )
+     {
+      if constexpr( ! std::is_same_v<std::chrono::duration<int_type, T_time>, std::chrono::duration<int_type>> )
+       {
+        static std::unordered_map<std::type_index, std::basic_string_view<T_str>> time_map
+         {
+          { typeid( std::nano ), StringConverter<T_str>( "ns" ) },
+          { typeid( std::micro ), StringConverter<T_str>( "us" ) },
+          { typeid( std::milli ), StringConverter<T_str>( "ms" ) },
+          { typeid( std::ratio<60> ), StringConverter<T_str>( "min" ) },
+          { typeid( std::ratio<3600> ), StringConverter<T_str>( "h" ) }
+         };
+  
+        #if ( __cplusplus >= 202002L )
+        time_map.insert( { typeid( std::ratio<86400> ), StringConverter<T_str>( "d" ) } );
+        time_map.insert( { typeid( std::ratio<604800> ), StringConverter<T_str>( "w" ) } );
+        time_map.insert( { typeid( std::ratio<2629746> ), StringConverter<T_str>( "mos" ) } );
+        time_map.insert( { typeid( std::ratio<31556952> ), StringConverter<T_str>( "y" ) } );
+        #endif
+         
+        os << val.count() << time_map[ typeid( T_time ) ];
+       }
+      else if constexpr( std::is_same_v<std::chrono::duration<int_type, T_time>, std::chrono::duration<int_type>> )
+       {
+        os << val.count() << 's';
+       }
+  
+      return os;
+     }
+  
+    // Overload for std::optional
+    /**
+     * @brief Operator << overload for std::optional printing.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T The type of the std::optional value.
+     * @param os The stream to which the time object is printed to.
+     * @param opt The std::optional value.
+     * @return std::basic_ostream<T_str>& The stream to which the time object is printed to.
+     */
+    template <class T_str, class T>
+    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, std::optional<T> const& opt )
+     {
+      if ( opt ) os << opt.value();
+      else os << "nullopt"; 
+      
+      return os;
+     }
+
+    // Overload for std::tuple
+    template<std::size_t...> 
+    struct seq{};
+
+    template<std::size_t N, std::size_t... Is>
+    struct gen_seq: gen_seq<N-1, N-1, Is...>{};
+
+    template<std::size_t... Is>
+    struct gen_seq<0, Is...> : seq<Is...>{};
+
+    template<class T_str, class Tuple, std::size_t... Is>
+    void print_tuple( std::basic_ostream<T_str>& os, const Tuple& tup, seq<Is...> )
+     {
+      using swallow = int[];
+      ( void )swallow{ 0, ( void( os << ( Is == 0 ? "" : ", " ) << std::get<Is>( tup ) ), 0 )... };
+     }
+    
+    template<class T_str, class... Args>
+    std::basic_ostream<T_str>& operator<<( std::basic_ostream<T_str>& os, const std::tuple<Args...>& tup )
+     {
+      os << "(";
+      print_tuple( os, tup, gen_seq<sizeof...( Args )>() );
+      os << ")";
+
+      return os;
+     }
+  
+    #endif
+  
+    //====================================================
+    //     Functions used to select printing format
+    //====================================================
+  
+    // hex_digits
+    /**
+     * @brief Lower-case digits used to render values in base 16.
+     */
+    inline constexpr char hex_digits[] = "0123456789abcdef";
+
+    // copy_ascii
+    /**
+     * @brief Function used to copy ASCII text into a buffer of any char type.
+     * 
+     * @tparam T_str The char type of the output buffer.
+     * @param out The output buffer.
+     * @param data The ASCII text.
+     * @param size The size of the text.
+     * @return T_str* The end of the copied text.
+     */
+    template <class T_str>
+    T_str* copy_ascii( T_str* out, const char* data, std::size_t size )
+     {
+      for( std::size_t i = 0; i < size; ++i ) *out++ = static_cast<T_str>( data[ i ] );
+      return out;
+     }
+
+    // append_hex
+    /**
+     * @brief Function used to render an unsigned value in base 16, with a "0x" prefix and without leading zeros.
+     * 
+     * @tparam T_str The char type of the output buffer.
+     * @param out The output buffer, which must hold at least 2 + 2 * sizeof( value ) characters.
+     * @param value The value to be rendered.
+     * @return T_str* The end of the rendered text.
+     */
+    template <class T_str>
+    T_str* append_hex( T_str* out, std::uintptr_t value )
+     {
+      char digits[ 2 * sizeof( std::uintptr_t ) ];
+      char* first = digits + sizeof( digits );
+      do
+       {
+        *--first = hex_digits[ value & 0xf ];
+        value >>= 4;
+       } while( value != 0 );
+
+      *out++ = '0';
+      *out++ = 'x';
+      return copy_ascii( out, first, static_cast<std::size_t>( digits + sizeof( digits ) - first ) );
+     }
+
+   }
+
+  // PointerInfo
+  /**
+   * @brief Class containing the value and the address of a pointer, rendered in base 16 into a fixed buffer.
+   * 
+   * @tparam T_str The char type of the rendered text.
+   */
+  template <class T_str = char>
+  class PointerInfo
+   {
+    public:
+
+     // Constructors
+     PointerInfo( const volatile void* value, const volatile void* address )
+      {
+       T_str* last = text_;
+       last = copy_ascii( last, "Value: ", 7 );
+       last = append_hex( last, reinterpret_cast<std::uintptr_t>( value ) );
+       last = copy_ascii( last, "\nAddress: ", 10 );
+       last = append_hex( last, reinterpret_cast<std::uintptr_t>( address ) );
+       size_ = static_cast<std::size_t>( last - text_ );
+      }
+
+     // Getters
+     const T_str* data() const noexcept { return text_; }
+     std::size_t size() const noexcept { return size_; }
+     std::basic_string_view<T_str> view() const noexcept { return { text_, size_ }; }
+     std::basic_string<T_str> str() const { return { text_, size_ }; }
+
+     // Conversion operators
+     operator std::basic_string<T_str>() const { return str(); }
+
+    private:
+
+     // Constants
+     static constexpr std::size_t capacity = 21 + 4 * sizeof( std::uintptr_t );
+
+     // Members
+     T_str text_[ capacity ];
+     std::size_t size_ = 0;
+   };
+
+  // operator <<
+  /**
+   * @brief Operator used to write the rendered pointer information to a stream, without any allocation.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @param os The stream object.
+   * @param info The pointer information.
+   * @return std::basic_ostream<T_str>& The stream to which the pointer information is printed to.
+   */
+  template <class T_str>
+  std::basic_ostream<T_str>& operator<<( std::basic_ostream<T_str>& os, const PointerInfo<T_str>& info )
+   {
+    return os.write( info.data(), static_cast<std::streamsize>( info.size() ) );
+   }
+
+  inline namespace detail
+   {
+
+    // ptr
+    /**
+     * @brief Function used to print memory and address information about a generic pointer. The result is rendered into a fixed buffer, so the function neither allocates nor shares any state between threads.
+     * 
+     * @tparam T_str The char type of the rendered text.
+     * @tparam T The type of the pointer.
+     * @param ptr The pointer.
+     * @return PointerInfo<T_str> The rendered value and address of the pointer, which can be printed or converted to std::basic_string<T_str>.
+     */
+    template <class T_str = char, class T>
+    PointerInfo<T_str> ptr( T* const& ptr )
+     {
+      return PointerInfo<T_str>( ptr, &ptr );
+     }
+
+    /**
+     * @brief Function used to write memory and address information about a generic pointer directly to a stream.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam T The type of the pointer.
+     * @param os The stream object.
+     * @param ptr The pointer.
+     * @return std::basic_ostream<T_str>& The stream to which the pointer information is printed to.
+     */
+    template <class T_str, class T>
+    std::basic_ostream<T_str>& ptr( std::basic_ostream<T_str>& os, T* const& ptr )
+     {
+      return os << PointerInfo<T_str>( ptr, &ptr );
+     }
+
+    /**
+     * @brief Function used to write memory and address information about a generic pointer to an output iterator.
+     * 
+     * @tparam T_str The char type of the rendered text.
+     * @tparam OutputIt The type of the output iterator.
+     * @tparam T The type of the pointer.
+     * @param out The output iterator.
+     * @param ptr The pointer.
+     * @return OutputIt The iterator past the last written character.
+     */
+    template <class T_str = char, class OutputIt, class T, std::enable_if_t<! std::is_base_of_v<std::ios_base, OutputIt>, int> = 0>
+    OutputIt ptr( OutputIt out, T* const& ptr )
+     {
+      const PointerInfo<T_str> info( ptr, &ptr );
+      for( std::size_t i = 0; i < info.size(); ++i, ++out ) *out = info.data()[ i ];
+      return out;
+     }
+
+    //====================================================
+    //     Type-erased argument writers
+    //====================================================
+
+    // Defined after all the operator << overloads, which must be visible when they are instantiated
+    // write_object
+    /**
+     * @brief Function used to write a type-erased object to a stream.
+     * 
+     * @tparam T_str The char type of the stream.
+     * @tparam T The type of the object.
+     * @param os The stream.
+     * @param value The address of the object.
+     */
+    template <class T_str, class T>
+    void write_object( std::basic_ostream<T_str>& os, const ErasedValue& value )
+     {
+      os << *static_cast<T*>( value.object );
+     }
+
+    // write_string
+    /**
+     * @brief Function used to write a type-erased C string to a stream.
+     * 
+     * @tparam T_str The char type of the stream.
+     * @tparam T_char The char type of the string.
+     * @param os The stream.
+     * @param value The address of the string.
+     */
+    template <class T_str, class T_char>
+    void write_string( std::basic_ostream<T_str>& os, const ErasedValue& value )
+     {
+      os << static_cast<const T_char*>( value.object );
+     }
+
+    // write_function
+    /**
+     * @brief Function used to write a type-erased function (e.g. a manipulator) to a stream.
+     * 
+     * @tparam T_str The char type of the stream.
+     * @tparam T The type of the function.
+     * @param os The stream.
+     * @param value The address of the function.
+     */
+    template <class T_str, class T>
+    void write_function( std::basic_ostream<T_str>& os, const ErasedValue& value )
+     {
+      os << reinterpret_cast<T*>( value.function );
+     }
+
+    //====================================================
+    //     Numbers and ASCII text
+    //====================================================
+
+    // is_char
+    /**
+     * @brief Variable template used to check if a type is one of the char types.
+     * 
+     * @tparam T The type.
+     */
+    template <class T>
+    inline constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+                                      std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+                                      #if ( __cplusplus >= 202002L )
+                                      || std::is_same_v<T, char8_t>
+                                      #endif
+                                      ;
+
+    // is_number
+    /**
+     * @brief Variable template used to check if a type is a number, i.e. an arithmetic type which is neither a boolean nor a char.
+     * 
+     * @tparam T The type.
+     */
+    template <class T>
+    inline constexpr bool is_number_v = std::is_arithmetic_v<T> && ! std::is_same_v<T, bool> && ! is_char_v<T>;
+
+    // append_ascii
+    /**
+     * @brief Function used to append an ASCII string to a string of any char type.
+     * 
+     * @tparam T_str The char type of the destination string.
+     * @param out The destination string.
+     * @param data The ASCII string.
+     * @param size The size of the ASCII string.
+     */
+    template <class T_str>
+    inline void append_ascii( std::basic_string<T_str>& out, const char* data, std::size_t size )
+     {
+      if constexpr( std::is_same_v<T_str, char> ) out.append( data, size );
+      else for( std::size_t i = 0; i < size; ++i ) out.push_back( static_cast<T_str>( data[i] ) );
+     }
+
+    // NumberFormat
+    /**
+     * @brief Struct used to store how the numbers have to be written to a stream with std::to_chars. It is disabled if the stream settings are not supported (e.g. showpos or a locale with thousands separators), in which case the numbers have to be written by the stream.
+     * 
+     */
+    struct NumberFormat
+     {
+      bool enabled = false;
+      int base = 10;
+      int precision = 6;
+      #ifdef PTC_HAS_TO_CHARS
+      std::chars_format format = std::chars_format::general;
+      #endif
+     };
+
+    // number_format
+    /**
+     * @brief Function used to get the NumberFormat which reproduces the number formatting of a stream. It inspects the stream locale, so it has to be called once for many numbers.
+     * 
+     * @tparam T_str The char type of the stream.
+     * @param settings The stream.
+     * @return NumberFormat The number format.
+     */
+    template <class T_str>
+    NumberFormat number_format( [[maybe_unused]] const std::basic_ios<T_str>& settings )
+     {
+      NumberFormat result;
+
+      #ifdef PTC_HAS_TO_CHARS
+      const std::ios_base::fmtflags flags = settings.flags();
+      if ( flags & ( std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::showbase | std::ios_base::uppercase ) ) return result;
+      const std::ios_base::fmtflags floatfield = flags & std::ios_base::floatfield;
+      if ( floatfield == ( std::ios_base::fixed | std::ios_base::scientific ) ) return result; // Hexfloat
+
+      const std::locale locale = settings.getloc();
+      if ( ! std::has_facet<std::numpunct<T_str>>( locale ) ) return result;
+      const auto& punct = std::use_facet<std::numpunct<T_str>>( locale );
+      if ( punct.decimal_point() != T_str( '.' ) || ! punct.grouping().empty() ) return result;
+
+      const std::ios_base::fmtflags basefield = flags & std::ios_base::basefield;
+      result.base = basefield == std::ios_base::hex ? 16 : basefield == std::ios_base::oct ? 8 : 10;
+      if ( floatfield == std::ios_base::fixed ) result.format = std::chars_format::fixed;
+      else if ( floatfield == std::ios_base::scientific ) result.format = std::chars_format::scientific;
+      result.precision = static_cast<int>( settings.precision() );
+      result.enabled = true;
+      #endif
+
+      return result;
+     }
+
+    // number_buffer_size
+    inline constexpr std::size_t number_buffer_size = 128;
+
+    // format_number
+    /**
+     * @brief Function used to write a number into a char buffer with std::to_chars, as a stream with the given NumberFormat would write it.
+     * 
+     * @tparam T The type of the number.
+     * @param first The beginning of the buffer.
+     * @param last The end of the buffer.
+     * @param value The number.
+     * @param format The number format.
+     * @return std::size_t The number of written chars, or zero if the number has to be written by the stream (e.g. if the format is disabled or the buffer is too small).
+     */
+    template <class T>
+    std::size_t format_number( [[maybe_unused]] char* first, [[maybe_unused]] char* last, [[maybe_unused]] T value, const NumberFormat& format )
+     {
+      if ( ! format.enabled ) return 0;
+
+      #ifdef PTC_HAS_TO_CHARS
+      std::to_chars_result result;
+      if constexpr( std::is_floating_point_v<T> ) result = std::to_chars( first, last, value, format.format, format.precision );
+      else if constexpr( std::is_signed_v<T> ) 
+       {
+        if ( format.base == 10 ) result = std::to_chars( first, last, value );
+        else result = std::to_chars( first, last, static_cast<std::make_unsigned_t<T>>( value ), format.base ); // Streams write the two's complement
+       }
+      else result = std::to_chars( first, last, value, format.base );
+
+      return result.ec == std::errc() ? static_cast<std::size_t>( result.ptr - first ) : 0;
+      #else
+      return 0;
+      #endif
+     }
+
+    //====================================================
+    //     Tables
+    //====================================================
+
+    // is_tuple_like
+    /**
+     * @brief Trait used to check if a type is tuple-like (std::tuple, std::pair, std::array...), i.e. if std::tuple_size is defined for it.
+     * 
+     * @tparam T The type.
+     */
+    template <class T, class = void>
+    struct is_tuple_like: std::false_type {};
+
+    template <class T>
+    struct is_tuple_like<T, std::void_t<decltype( std::tuple_size<T>::value )>>: std::true_type {};
+
+    // for_each_cell
+    /**
+     * @brief Function used to call a function on each cell of a table row, which can be a tuple-like object or a range.
+     * 
+     * @tparam Row The type of the row.
+     * @tparam Function The type of the function.
+     * @param row The row.
+     * @param function The function.
+     */
+    template <class Row, class Function>
+    void for_each_cell( const Row& row, Function&& function )
+     {
+      if constexpr( is_tuple_like<Row>::value ) std::apply( [ &function ]( const auto&... cells ){ ( function( cells ), ... ); }, row );
+      else for( const auto& cell: row ) function( cell );
+     }
+
+    // display_width
+    /**
+     * @brief Function used to compute the number of columns taken by a string on a terminal: ANSI escape sequences take no column and, for char strings, each UTF-8 code point takes one column.
+     * 
+     * @tparam T_str The char type of the string.
+     * @param data The string.
+     * @param size The size of the string.
+     * @param escape Set to true if the string contains an ANSI escape sequence.
+     * @return std::size_t The number of columns.
+     */
+    template <class T_str>
+    std::size_t display_width( const T_str* data, std::size_t size, bool& escape )
+     {
+      std::size_t width = 0;
+      for( std::size_t i = 0; i < size; ++i )
+       {
+        if ( data[i] == T_str( '\033' ) )
+         {
+          escape = true;
+          if ( i + 1 < size && data[i + 1] == T_str( '[' ) )
+           {
+            for( i += 2; i < size && ! ( data[i] >= T_str( '@' ) && data[i] <= T_str( '~' ) ); ++i );
+           }
+          continue;
+         }
+        if constexpr( std::is_same_v<T_str, char> )
+         {
+          if ( ( static_cast<unsigned char>( data[i] ) & 0xC0 ) == 0x80 ) continue; // UTF-8 continuation byte
+         }
+        ++width;
+       }
+      return width;
+     }
+
+    // TableArena
+    /**
+     * @brief Struct used to format the cells of a table once, into a single buffer, and to build the padded table before it is written. Its storage is kept between tables, in order to avoid reallocations.
+     * 
+     * @tparam T_str The char type of the table.
+     */
+    template <class T_str>
+    struct TableArena
+     {
+      struct Cell
+       {
+        std::size_t pos, size, width;
+        bool right;
+       };
+
+      LineBuffer<T_str> buffer;
+      std::basic_ostream<T_str> os{ &buffer };
+      std::vector<Cell> cells;
+      std::vector<std::size_t> row_ends, widths;
+      std::basic_string<T_str> text;
+      NumberFormat format;
+      bool escape = false;
+
+      // reset
+      /**
+       * @brief Method used to empty the arena and to copy the formatting settings of the output stream.
+       * 
+       * @param target The output stream.
+       */
+      void reset( const std::basic_ostream<T_str>& target )
+       {
+        buffer.clear();
+        cells.clear();
+        row_ends.clear();
+        widths.clear();
+        text.clear();
+        escape = false;
+        os.flags( target.flags() );
+        os.precision( target.precision() );
+        if ( os.getloc() != target.getloc() ) os.imbue( target.getloc() );
+        format = number_format( target );
+       }
+
+      // add
+      /**
+       * @brief Method used to format a cell at the end of the current row and to update the width of its column. Numbers are right-aligned and all the other cells are left-aligned.
+       * 
+       * @tparam T The type of the cell.
+       * @param cell The cell.
+       */
+      template <class T>
+      void add( const T& cell )
+       {
+        const std::size_t column = cells.size() - ( row_ends.empty() ? 0 : row_ends.back() );
+        const std::size_t pos = buffer.size();
+        write_cell( cell );
+        const std::size_t size = buffer.size() - pos;
+        const std::size_t width = display_width( buffer.data() + pos, size, escape );
+        cells.push_back( { pos, size, width, is_number_v<T> } );
+        if ( widths.size() <= column ) widths.resize( column + 1, 0 );
+        if ( width > widths[column] ) widths[column] = width;
+       }
+
+      // write_cell
+      /**
+       * @brief Method used to format a cell into the buffer. Numbers are written with std::to_chars if possible.
+       * 
+       * @tparam T The type of the cell.
+       * @param cell The cell.
+       */
+      template <class T>
+      void write_cell( const T& cell )
+       {
+        if constexpr( is_number_v<T> )
+         {
+          char digits[ number_buffer_size ];
+          const std::size_t size = format_number( digits, digits + number_buffer_size, cell, format );
+          if ( size > 0 )
+           {
+            if constexpr( std::is_same_v<T_str, char> ) buffer.sputn( digits, static_cast<std::streamsize>( size ) );
+            else for( std::size_t i = 0; i < size; ++i ) buffer.sputc( static_cast<T_str>( digits[i] ) );
+            return;
+           }
+         }
+        os << cell;
+       }
+
+      // end_row
+      /**
+       * @brief Method used to terminate the current row.
+       * 
+       */
+      void end_row()
+       {
+        row_ends.push_back( cells.size() );
+       }
+
+      // append_row
+      /**
+       * @brief Method used to append a row of formatted cells to the table text, each one padded to the width of its column. The last cell of the row is not padded if left-aligned.
+       * 
+       * @param first The index of the first cell of the row.
+       * @param last The index after the last cell of the row.
+       * @param column_widths The widths of the columns.
+       * @param sep The columns separator.
+       * @param end The row terminator.
+       */
+      void append_row( std::size_t first, std::size_t last, const std::vector<std::size_t>& column_widths, const std::basic_string<T_str>& sep, const std::basic_string<T_str>& end )
+       {
+        for( std::size_t i = first; i < last; ++i )
+         {
+          const Cell& cell = cells[i];
+          const std::size_t column = i - first;
+          const std::size_t column_width = column < column_widths.size() ? column_widths[column] : 0;
+          const std::size_t padding = column_width > cell.width ? column_width - cell.width : 0;
+          if ( column > 0 ) text += sep;
+          if ( cell.right ) text.append( padding, T_str( ' ' ) );
+          text.append( buffer.data() + cell.pos, cell.size );
+          if ( ! cell.right && i + 1 < last ) text.append( padding, T_str( ' ' ) );
+         }
+        text += end;
+       }
+
+      // append_rule
+      /**
+       * @brief Method used to append the rule which separates the headers from the rows.
+       * 
+       * @param column_widths The widths of the columns.
+       * @param sep The columns separator.
+       * @param end The row terminator.
+       */
+      void append_rule( const std::vector<std::size_t>& column_widths, const std::basic_string<T_str>& sep, const std::basic_string<T_str>& end )
+       {
+        for( std::size_t column = 0; column < column_widths.size(); ++column )
+         {
+          if ( column > 0 ) text += sep;
+          text.append( column_widths[column], T_str( '-' ) );
+         }
+        text += end;
+       }
+     };
+
+    // table_arena
+    /**
+     * @brief Function used to get the thread-local TableArena object, in order to build tables without any locking.
+     * 
+     * @tparam T_str The char type of the table.
+     * @return TableArena<T_str>& The TableArena of the calling thread.
+     */
+    template <class T_str>
+    inline TableArena<T_str>& table_arena()
+     {
+      thread_local TableArena<T_str> arena;
+      return arena;
+     }
+
+    //====================================================
+    //     Nested ranges
+    //====================================================
+
+    // is_text
+    /**
+     * @brief Trait used to check if a type is a string (std::basic_string, std::basic_string_view or an array of chars), which is printed as a whole and not as a range.
+     * 
+     * @tparam T The type.
+     */
+    template <class T>
+    struct is_text: std::false_type {};
+
+    template <class T_char, class Traits, class Alloc>
+    struct is_text<std::basic_string<T_char, Traits, Alloc>>: std::true_type {};
+
+    template <class T_char, class Traits>
+    struct is_text<std::basic_string_view<T_char, Traits>>: std::true_type {};
+
+    template <class T_char, std::size_t size>
+    struct is_text<T_char[ size ]>: std::bool_constant<is_char_v<std::remove_cv_t<T_char>>> {};
+
+    // is_nested
+    /**
+     * @brief Trait used to check if an element of a nested range is a range itself (and not a string).
+     * 
+     * @tparam T The type of the element.
+     */
+    template <class T, class = void>
+    struct is_nested: std::false_type {};
+
+    template <class T>
+    struct is_nested<T, std::void_t<decltype( std::begin( std::declval<const T&>() ) ), decltype( std::end( std::declval<const T&>() ) )>>: 
+      std::bool_constant< ! is_text<T>::value> {};
+
+    // NestedArena
+    /**
+     * @brief Struct used to build the text of a nested range before it is written with a single operation. Its storage is kept between calls, in order to avoid reallocations.
+     * 
+     * @tparam T_str The char type of the text.
+     */
+    template <class T_str>
+    struct NestedArena
+     {
+      struct Leaf
+       {
+        std::size_t pos, size, width;
+       };
+
+      LineBuffer<T_str> buffer;
+      std::basic_ostream<T_str> os{ &buffer };
+      std::basic_string<T_str> text, leaves_text;
+      std::vector<Leaf> leaves;
+      std::size_t width = 0, next = 0;
+      NumberFormat format;
+
+      // reset
+      /**
+       * @brief Method used to empty the arena and to copy the formatting settings of the output stream.
+       * 
+       * @param target The output stream.
+       */
+      void reset( const std::basic_ostream<T_str>& target )
+       {
+        text.clear();
+        leaves_text.clear();
+        leaves.clear();
+        width = 0;
+        next = 0;
+        os.flags( target.flags() );
+        os.precision( target.precision() );
+        if ( os.getloc() != target.getloc() ) os.imbue( target.getloc() );
+        format = number_format( target );
+       }
+
+      // append_leaf
+      /**
+       * @brief Method used to append an element which is not a range to a string. Numbers are written with std::to_chars if possible, the other elements through the stream.
+       * 
+       * @tparam T The type of the element.
+       * @param out The string.
+       * @param leaf The element.
+       */
+      template <class T>
+      void append_leaf( std::basic_string<T_str>& out, const T& leaf )
+       {
+        if constexpr( is_number_v<T> )
+         {
+          char digits[ number_buffer_size ];
+          const std::size_t size = format_number( digits, digits + number_buffer_size, leaf, format );
+          if ( size > 0 )
+           {
+            append_ascii( out, digits, size );
+            return;
+           }
+         }
+        buffer.clear();
+        os << leaf;
+        out.append( buffer.data(), buffer.size() );
+       }
+
+      // collect
+      /**
+       * @brief Method used to format all the elements of a nested range, recording their position and the width of the widest one.
+       * 
+       * @tparam Range The type of the range.
+       * @param range The range.
+       */
+      template <class Range>
+      void collect( const Range& range )
+       {
+        for( const auto& element: range )
+         {
+          if constexpr( is_nested<std::decay_t<decltype( element )>>::value ) collect( element );
+          else
+           {
+            const std::size_t pos = leaves_text.size();
+            append_leaf( leaves_text, element );
+            bool escape = false;
+            const std::size_t leaf_width = display_width( leaves_text.data() + pos, leaves_text.size() - pos, escape );
+            leaves.push_back( { pos, leaves_text.size() - pos, leaf_width } );
+            if ( leaf_width > width ) width = leaf_width;
+           }
+         }
+       }
+
+      // emit
+      /**
+       * @brief Method used to append a nested range to the text, as "[[1, 2], [3, 4]]". In the aligned layout, the elements are taken from the collected ones and right-aligned to the widest, while each nested range after the first one starts on a new line, indented by its depth.
+       * 
+       * @tparam Range The type of the range.
+       * @param range The range.
+       * @param depth The depth of the range.
+       * @param aligned If true the aligned layout is used.
+       */
+      template <class Range>
+      void emit( const Range& range, std::size_t depth, bool aligned )
+       {
+        text.push_back( T_str( '[' ) );
+        bool first = true;
+        for( const auto& element: range )
+         {
+          if constexpr( is_nested<std::decay_t<decltype( element )>>::value )
+           {
+            if ( ! first )
+             {
+              text.push_back( T_str( ',' ) );
+              if ( aligned )
+               {
+                text.push_back( T_str( '\n' ) );
+                text.append( depth + 1, T_str( ' ' ) );
+               }
+              else text.push_back( T_str( ' ' ) );
+             }
+            emit( element, depth + 1, aligned );
+           }
+          else
+           {
+            if ( ! first )
+             {
+              text.push_back( T_str( ',' ) );
+              text.push_back( T_str( ' ' ) );
+             }
+            if ( aligned )
+             {
+              const Leaf& leaf = leaves[ next++ ];
+              text.append( width - leaf.width, T_str( ' ' ) );
+              text.append( leaves_text, leaf.pos, leaf.size );
+             }
+            else append_leaf( text, element );
+           }
+          first = false;
+         }
+        text.push_back( T_str( ']' ) );
+       }
+     };
+
+    // nested_arena
+    /**
+     * @brief Function used to get the thread-local NestedArena object, in order to print nested ranges without any locking.
+     * 
+     * @tparam T_str The char type of the text.
+     * @return NestedArena<T_str>& The NestedArena of the calling thread.
+     */
+    template <class T_str>
+    inline NestedArena<T_str>& nested_arena()
+     {
+      thread_local NestedArena<T_str> arena;
+      return arena;
+     }
+
+    // is_sized
+    /**
+     * @brief Trait used to check if the size of a range is known without iterating over it (std::size is defined for it).
+     * 
+     * @tparam T The type of the range.
+     */
+    template <class T, class = void>
+    struct is_sized: std::false_type {};
+
+    template <class T>
+    struct is_sized<T, std::void_t<decltype( std::size( std::declval<const T&>() ) )>>: std::true_type {};
+
+    // nested_size
+    /**
+     * @brief Function used to count the elements and the ranges of a nested range without iterating over the elements, if all its levels have a size.
+     * 
+     * @tparam Range The type of the range.
+     * @param range The range.
+     * @param leaves The number of elements, increased by the function.
+     * @param ranges The number of ranges, increased by the function.
+     * @return true If the counts are known.
+     * @return false Otherwise.
+     */
+    template <class Range>
+    bool nested_size( const Range& range, std::size_t& leaves, std::size_t& ranges )
+     {
+      if constexpr( is_sized<Range>::value )
+       {
+        ++ranges;
+        using element_type = std::decay_t<decltype( *std::begin( range ) )>;
+        if constexpr( is_nested<element_type>::value )
+         {
+          for( const auto& element: range ) 
+           {
+            if ( ! nested_size( element, leaves, ranges ) ) return false;
+           }
+         }
+        else leaves += static_cast<std::size_t>( std::size( range ) );
+        return true;
+       }
+      else return false;
+     }
+   }
+
+  //====================================================
+  //     Nested ranges printing
+  //====================================================
+
+  // Nested
+  /**
+   * @brief Struct used to print a nested range (e.g. a matrix) to a stream with ptc::nested.
+   * 
+   * @tparam Range The type of the range: a reference for ranges passed as lvalues, the range itself for the temporary ones, which are moved into the object so that it can be printed later.
+   */
+  template <class Range>
+  struct Nested
+   {
+    Range range;
+    layout mode;
+   };
+
+  // nested
+  /**
+   * @brief Function used to print a nested range (e.g. a std::vector<std::vector<double>> matrix) with a single write. Elements are formatted directly into a reusable per-thread buffer (numbers with std::to_chars, following the stream settings), instead of being written to the stream one by one. For example: ptc::print( ptc::nested( matrix, ptc::layout::aligned ) ).
+   * 
+   * @tparam Range The type of the range.
+   * @param range The range. Lvalues are referenced and temporaries are stored.
+   * @param mode The layout.
+   * @return Nested<Range> The object to be printed.
+   */
+  template <class Range>
+  inline Nested<Range> nested( Range&& range, layout mode = layout::compact )
+   {
+    return { std::forward<Range>( range ), mode };
+   }
+
+  // Overload for nested ranges printing
+  /**
+   * @brief Operator << overload for nested ranges printing. The size of the text is computed up front if all the levels of the range have a size.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @tparam Range The type of the range.
+   * @param os The stream to which the range is printed to.
+   * @param nested The range.
+   * @return std::basic_ostream<T_str>& The stream to which the range is printed to.
+   */
+  template <class T_str, class Range>
+  std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const Nested<Range>& nested )
+   {
+    NestedArena<T_str>& arena = nested_arena<T_str>();
+    arena.reset( os );
+    const bool aligned = nested.mode == layout::aligned;
+    if ( aligned ) arena.collect( nested.range );
+
+    // Reserving the text (an estimate for the compact layout)
+    std::size_t leaves = 0, ranges = 0;
+    if ( nested_size( nested.range, leaves, ranges ) )
+     {
+      const std::size_t leaf_size = aligned ? arena.width : arena.format.precision + 4;
+      arena.text.reserve( leaves * ( leaf_size + 2 ) + ranges * ( aligned ? 16 : 4 ) );
+     }
+
+    arena.emit( nested.range, 0, aligned );
+    os.write( arena.text.data(), static_cast<std::streamsize>( arena.text.size() ) );
+    os.width( 0 );
+
+    return os;
+   }
+
+  #if defined( PTC_HAS_RANGES ) && ! defined( PTC_DISABLE_STD_TYPES_PRINTING )
+
+  //====================================================
+  //     Ranges printing
+  //====================================================
+
+  // Limited
+  /**
+   * @brief Struct used to print at most a given number of elements of a range with ptc::limit. The view is mutable since printing may advance it (e.g. std::views::filter caches its first element).
+   * 
+   * @tparam View The type of the view over the range.
+   */
+  template <class View>
+  struct Limited
+   {
+    mutable View range;
+    std::size_t count;
+   };
+
+  // limit
+  /**
+   * @brief Function used to print at most "count" elements of a range, even an infinite one (e.g. std::views::iota( 0 )). If the range has more elements they are replaced by "...". For example: ptc::print( ptc::limit( values, 10 ) ).
+   * 
+   * @tparam Range The type of the range.
+   * @param range The range. Containers are referenced and views are stored.
+   * @param count The maximum number of printed elements.
+   * @return Limited<std::views::all_t<Range>> The object to be printed.
+   */
+  template <std::ranges::viewable_range Range>
+  inline Limited<std::views::all_t<Range>> limit( Range&& range, std::size_t count )
+   {
+    return { std::views::all( std::forward<Range>( range ) ), count };
+   }
+
+  inline namespace detail
+   {
+    // is_bulk_range_v
+    /**
+     * @brief Trait used to check if a range is contiguous and contains numbers, so that it can be printed with a single write through ptc::nested.
+     * 
+     * @tparam Range The type of the range.
+     */
+    template <class Range>
+    concept bulk_range = std::ranges::contiguous_range<const Range> && std::ranges::sized_range<const Range> && 
+                         is_number_v<std::ranges::range_value_t<const Range>>;
+
+    template <class Range>
+    inline constexpr bool is_bulk_range_v = bulk_range<Range>;
+
+    // write_lazy_range
+    /**
+     * @brief Function used to print the elements of a range one by one, as they are produced, without materializing it.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam Range The type of the range.
+     * @param os The stream to which the range is printed to.
+     * @param range The range.
+     * @param count The maximum number of printed elements.
+     */
+    template <class T_str, class Range>
+    void write_lazy_range( std::basic_ostream<T_str>& os, Range& range, std::size_t count )
+     {
+      os << '[';
+      auto it = std::ranges::begin( range );
+      const auto last = std::ranges::end( range );
+      for( std::size_t i = 0; it != last; ++it, ++i )
+       {
+        if ( i != 0 ) os << ", ";
+        if ( i == count )
+         {
+          os << "...";
+          break;
+         }
+        os << *it;
+       }
+      os << ']';
+     }
+
+    // Overload for ranges views printing
+    /**
+     * @brief Operator << overload for ranges views printing (e.g. std::span or the results of std::views::filter and std::views::transform). Elements are consumed lazily, while contiguous ranges of numbers are printed in bulk with ptc::nested. Infinite ranges must be printed with ptc::limit.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @tparam Range The type of the range.
+     * @param os The stream to which the range is printed to.
+     * @param range The range.
+     * @return std::basic_ostream<T_str>& The stream to which the range is printed to.
+     */
+    template <class T_str, class Range>
+    requires is_lazy_range_v<std::remove_cvref_t<Range>> && std::ranges::input_range<Range>
+    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, Range&& range )
+     {
+      static_assert( ! std::is_same_v<std::ranges::sentinel_t<Range>, std::unreachable_sentinel_t>, "Infinite ranges must be printed with ptc::limit." );
+
+      if constexpr( is_bulk_range_v<std::remove_cvref_t<Range>> ) return os << nested( range );
+      else
+       {
+        write_lazy_range( os, range, static_cast<std::size_t>( -1 ) );
+        return os;
+       }
+     }
+   }
+
+  // Overload for limited ranges printing
+  /**
+   * @brief Operator << overload for limited ranges printing.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @tparam View The type of the view over the range.
+   * @param os The stream to which the range is printed to.
+   * @param limited The range and the maximum number of printed elements.
+   * @return std::basic_ostream<T_str>& The stream to which the range is printed to.
+   */
+  template <class T_str, class View>
+  std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const Limited<View>& limited )
+   {
+    if constexpr( is_bulk_range_v<View> )
+     {
+      if ( std::ranges::size( limited.range ) <= limited.count ) return os << nested( std::as_const( limited.range ) );
+     }
+    write_lazy_range( os, limited.range, limited.count );
+
+    return os;
+   }
+
+  #endif
+
+  //====================================================
+  //     Bytes printing
+  //====================================================
+  inline namespace detail
+   {
+    // HexPairs
+    /**
+     * @brief Struct containing the two hexadecimal digits of every byte value, used as a lookup table.
+     * 
+     */
+    struct HexPairs
+     {
+      char text[ 512 ];
+
+      constexpr HexPairs(): text()
+       {
+        for( std::size_t i = 0; i < 256; ++i )
+         {
+          text[ 2 * i ] = hex_digits[ i >> 4 ];
+          text[ 2 * i + 1 ] = hex_digits[ i & 0xf ];
+         }
+       }
+     };
+
+    inline constexpr HexPairs hex_pairs{};
+
+    // hex_encode
+    /**
+     * @brief Function used to convert bytes to hexadecimal digits (two for each byte). Blocks of 16 bytes are converted with SSSE3 if available, the others with a lookup table.
+     * 
+     * @param out The output buffer, which must hold at least 2 * size characters.
+     * @param data The bytes.
+     * @param size The number of bytes.
+     * @return char* The end of the converted text.
+     */
+    inline char* hex_encode( char* out, const unsigned char* data, std::size_t size )
+     {
+      #ifdef PTC_HAS_SSSE3
+      const __m128i digits = _mm_setr_epi8( '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' );
+      const __m128i low_mask = _mm_set1_epi8( 0x0f );
+      for( ; size >= 16; size -= 16, data += 16, out += 32 )
+       {
+        const __m128i bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data ) );
+        const __m128i high = _mm_shuffle_epi8( digits, _mm_and_si128( _mm_srli_epi16( bytes, 4 ), low_mask ) );
+        const __m128i low = _mm_shuffle_epi8( digits, _mm_and_si128( bytes, low_mask ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( out ), _mm_unpacklo_epi8( high, low ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( out + 16 ), _mm_unpackhi_epi8( high, low ) );
+       }
+      #endif
+
+      for( std::size_t i = 0; i < size; ++i, out += 2 )
+       {
+        out[ 0 ] = hex_pairs.text[ 2 * data[ i ] ];
+        out[ 1 ] = hex_pairs.text[ 2 * data[ i ] + 1 ];
+       }
+      return out;
+     }
+
+    // hexdump_line_size
+    /**
+     * @brief Maximum size of a line of an hexdump.
+     */
+    inline constexpr std::size_t hexdump_line_size = 16 + 2 + 16 * 3 + 1 + 1 + 16 + 2;
+
+    // hexdump_line
+    /**
+     * @brief Function used to write a line of an hexdump: the offset, up to 16 bytes in hexadecimal (in two groups of 8) and the bytes as ASCII text, in which non-printable characters are replaced by dots.
+     * 
+     * @param out The output buffer, which must hold at least hexdump_line_size characters.
+     * @param data The bytes of the line.
+     * @param size The number of bytes of the line (at most 16).
+     * @param offset The offset of the line.
+     * @return char* The end of the line.
+     */
+    inline char* hexdump_line( char* out, const unsigned char* data, std::size_t size, std::size_t offset )
+     {
+      for( int shift = ( static_cast<std::uint64_t>( offset ) >> 32 ) != 0 ? 60 : 28; shift >= 0; shift -= 4 )
+       {
+        *out++ = hex_digits[ ( static_cast<std::uint64_t>( offset ) >> shift ) & 0xf ];
+       }
+      *out++ = ' ';
+
+      char digits[ 32 ];
+      hex_encode( digits, data, size );
+      for( std::size_t i = 0; i < 16; ++i )
+       {
+        if ( i % 8 == 0 ) *out++ = ' ';
+        out[ 0 ] = i < size ? digits[ 2 * i ] : ' ';
+        out[ 1 ] = i < size ? digits[ 2 * i + 1 ] : ' ';
+        out[ 2 ] = ' ';
+        out += 3;
+       }
+
+      *out++ = ' ';
+      *out++ = '|';
+      for( std::size_t i = 0; i < size; ++i ) *out++ = data[ i ] >= 0x20 && data[ i ] < 0x7f ? static_cast<char>( data[ i ] ) : '.';
+      *out++ = '|';
+      return out;
+     }
+
+    // write_ascii
+    /**
+     * @brief Function used to write ASCII text to a stream of any char type.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @param os The stream object.
+     * @param data The text.
+     * @param size The size of the text.
+     */
+    template <class T_str>
+    void write_ascii( std::basic_ostream<T_str>& os, const char* data, std::size_t size )
+     {
+      if constexpr( std::is_same_v<T_str, char> ) os.write( data, static_cast<std::streamsize>( size ) );
+      else
+       {
+        T_str wide[ 256 ];
+        for( std::size_t done = 0; done < size; )
+         {
+          const std::size_t count = size - done < 256 ? size - done : 256;
+          copy_ascii( wide, data + done, count );
+          os.write( wide, static_cast<std::streamsize>( count ) );
+          done += count;
+         }
+       }
+     }
+
+    // is_byte_range
+    /**
+     * @brief Trait used to check if a type is a contiguous range of single-byte elements (e.g. std::vector<std::uint8_t>, std::string, std::array<std::byte, N> or std::span<const std::byte>).
+     * 
+     * @tparam T The type.
+     */
+    template <class T, class = void>
+    struct is_byte_range: std::false_type {};
+
+    template <class T>
+    struct is_byte_range<T, std::void_t<decltype( std::data( std::declval<const T&>() ) ), decltype( std::size( std::declval<const T&>() ) )>>:
+      std::bool_constant<sizeof( *std::data( std::declval<const T&>() ) ) == 1> {};
+   }
+
+  // HexBytes
+  /**
+   * @brief Struct used to print bytes in hexadecimal with ptc::hex_bytes. The bytes are referenced, while the separator is stored.
+   * 
+   */
+  struct HexBytes
+   {
+    const unsigned char* data;
+    std::size_t size;
+    std::string separator;
+   };
+
+  // HexDump
+  /**
+   * @brief Struct used to print bytes in the classic hexdump layout with ptc::hexdump.
+   * 
+   */
+  struct HexDump
+   {
+    const unsigned char* data;
+    std::size_t size;
+   };
+
+  // hex_bytes
+  /**
+   * @brief Function used to print bytes in hexadecimal, two digits per byte, optionally separated. For example: ptc::print( ptc::hex_bytes( packet, size, " " ) ) prints "de ad be ef".
+   * 
+   * @param data The bytes.
+   * @param size The number of bytes.
+   * @param separator The separator printed between two bytes.
+   * @return HexBytes The object to be printed.
+   */
+  inline HexBytes hex_bytes( const void* data, std::size_t size, std::string_view separator = "" )
+   {
+    return { static_cast<const unsigned char*>( data ), size, std::string( separator ) };
+   }
+
+  /**
+   * @brief Function used to print a contiguous range of bytes in hexadecimal, two digits per byte, optionally separated. The range is referenced, so it must outlive the returned object.
+   * 
+   * @tparam Range The type of the range, whose elements must be of one byte (std::byte, char, std::uint8_t...).
+   * @param bytes The range.
+   * @param separator The separator printed between two bytes.
+   * @return HexBytes The object to be printed.
+   */
+  template <class Range, std::enable_if_t<is_byte_range<Range>::value, int> = 0>
+  inline HexBytes hex_bytes( const Range& bytes, std::string_view separator = "" )
+   {
+    return hex_bytes( std::data( bytes ), static_cast<std::size_t>( std::size( bytes ) ), separator );
+   }
+
+  // hexdump
+  /**
+   * @brief Function used to print bytes in the classic hexdump layout (as "hexdump -C"): one line for every 16 bytes, with the offset, the bytes in hexadecimal and the bytes as ASCII text.
+   * 
+   * @param data The bytes.
+   * @param size The number of bytes.
+   * @return HexDump The object to be printed.
+   */
+  inline HexDump hexdump( const void* data, std::size_t size )
+   {
+    return { static_cast<const unsigned char*>( data ), size };
+   }
+
+  /**
+   * @brief Function used to print a contiguous range of bytes in the classic hexdump layout. The range is referenced, so it must outlive the returned object.
+   * 
+   * @tparam Range The type of the range, whose elements must be of one byte (std::byte, char, std::uint8_t...).
+   * @param bytes The range.
+   * @return HexDump The object to be printed.
+   */
+  template <class Range, std::enable_if_t<is_byte_range<Range>::value, int> = 0>
+  inline HexDump hexdump( const Range& bytes )
+   {
+    return hexdump( std::data( bytes ), static_cast<std::size_t>( std::size( bytes ) ) );
+   }
+
+  // Overload for bytes printing in hexadecimal
+  /**
+   * @brief Operator << overload for bytes printing in hexadecimal. The text is built in a stack buffer and written in chunks.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @param os The stream to which the bytes are printed to.
+   * @param bytes The bytes.
+   * @return std::basic_ostream<T_str>& The stream to which the bytes are printed to.
+   */
+  template <class T_str>
+  std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const HexBytes& bytes )
+   {
+    char chunk[ 2048 ];
+    const std::size_t separator = bytes.separator.size();
+    if ( separator == 0 )
+     {
+      for( std::size_t done = 0; done < bytes.size; )
+       {
+        const std::size_t count = bytes.size - done < sizeof( chunk ) / 2 ? bytes.size - done : sizeof( chunk ) / 2;
+        hex_encode( chunk, bytes.data + done, count );
+        write_ascii( os, chunk, 2 * count );
+        done += count;
+       }
+     }
+    else
+     {
+      std::size_t used = 0;
+      for( std::size_t i = 0; i < bytes.size; ++i )
+       {
+        if ( used + 2 + separator > sizeof( chunk ) )
+         {
+          write_ascii( os, chunk, used );
+          used = 0;
+         }
+        if ( i != 0 )
+         {
+          if ( separator > sizeof( chunk ) - 2 ) write_ascii( os, bytes.separator.data(), separator );
+          else
+           {
+            bytes.separator.copy( chunk + used, separator );
+            used += separator;
+           }
+         }
+        chunk[ used ] = hex_pairs.text[ 2 * bytes.data[ i ] ];
+        chunk[ used + 1 ] = hex_pairs.text[ 2 * bytes.data[ i ] + 1 ];
+        used += 2;
+       }
+      write_ascii( os, chunk, used );
+     }
+
+    return os;
+   }
+
+  // Overload for bytes printing in the hexdump layout
+  /**
+   * @brief Operator << overload for bytes printing in the hexdump layout. Lines are separated by newlines, without a trailing one.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @param os The stream to which the bytes are printed to.
+   * @param dump The bytes.
+   * @return std::basic_ostream<T_str>& The stream to which the bytes are printed to.
+   */
+  template <class T_str>
+  std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const HexDump& dump )
+   {
+    char chunk[ 32 * ( hexdump_line_size + 1 ) ];
+    char* out = chunk;
+    for( std::size_t offset = 0; offset < dump.size; offset += 16 )
+     {
+      if ( out + hexdump_line_size + 1 > chunk + sizeof( chunk ) )
+       {
+        write_ascii( os, chunk, static_cast<std::size_t>( out - chunk ) );
+        out = chunk;
+       }
+      if ( offset != 0 ) *out++ = '\n';
+      out = hexdump_line( out, dump.data + offset, dump.size - offset < 16 ? dump.size - offset : 16, offset );
+     }
+    write_ascii( os, chunk, static_cast<std::size_t>( out - chunk ) );
+
+    return os;
+   }
+
+  //====================================================
+  //     Numbers formatting
+  //====================================================
+
+  // Formatted
+  /**
+   * @brief Struct used to print a number with a given format (see ptc::hex, ptc::bin, ptc::fixed and ptc::sci), without using nor changing the stream settings.
+   * 
+   * @tparam T The type of the number.
+   */
+  template <class T>
+  struct Formatted
+   {
+    T value;
+    int base;        ///< Base of integers: 2, 8, 10 or 16.
+    char style;      ///< Notation of floating-point numbers: 'g' (general), 'f' (fixed), 'e' (scientific) or 'a' (hexadecimal).
+    int precision;   ///< Precision of floating-point numbers, or -1 for the shortest exact representation.
+   };
+
+  // Padded
+  /**
+   * @brief Struct used to print a value right-aligned in a field of a given width with ptc::pad, without using nor changing the stream settings.
+   * 
+   * @tparam T The type of the value (a number, a Formatted number or a std::string_view).
+   */
+  template <class T>
+  struct Padded
+   {
+    T value;
+    std::size_t width;
+    char fill;
+   };
+
+  inline namespace detail
+   {
+    // is_formatted
+    /**
+     * @brief Trait used to check if a type is a Formatted number.
+     * 
+     * @tparam T The type.
+     */
+    template <class T>
+    struct is_formatted: std::false_type {};
+
+    template <class T>
+    struct is_formatted<Formatted<T>>: std::true_type {};
+   }
+
+  // hex
+  /**
+   * @brief Function used to print a number in hexadecimal, without the "0x" prefix (e.g. ff). Chars are printed as numbers, negative integers in two's complement (as streams do) and floating-point numbers in the hexadecimal exponent notation.
+   * 
+   * @tparam T The type of the number.
+   * @param value The number.
+   * @return Formatted<T> The object to be printed.
+   */
+  template <class T>
+  inline Formatted<T> hex( T value )
+   {
+    static_assert( std::is_arithmetic_v<T> && ! std::is_same_v<T, bool>, "ptc::hex requires a number." );
+    return { value, 16, std::is_floating_point_v<T> ? 'a' : 'g', -1 };
+   }
+
+  // bin
+  /**
+   * @brief Function used to print an integer in binary, without the "0b" prefix (e.g. 101). Chars are printed as numbers and negative integers in two's complement.
+   * 
+   * @tparam T The type of the integer.
+   * @param value The integer.
+   * @return Formatted<T> The object to be printed.
+   */
+  template <class T>
+  inline Formatted<T> bin( T value )
+   {
+    static_assert( std::is_integral_v<T> && ! std::is_same_v<T, bool>, "ptc::bin requires an integer." );
+    return { value, 2, 'g', -1 };
+   }
+
+  // fixed
+  /**
+   * @brief Function used to print a number in fixed notation (e.g. 3.14 with precision 2). Integers are converted to double.
+   * 
+   * @tparam T The type of the number.
+   * @param value The number.
+   * @param precision The number of digits after the decimal point.
+   * @return Formatted<std::conditional_t<std::is_floating_point_v<T>, T, double>> The object to be printed.
+   */
+  template <class T>
+  inline Formatted<std::conditional_t<std::is_floating_point_v<T>, T, double>> fixed( T value, int precision = 6 )
+   {
+    static_assert( is_number_v<T>, "ptc::fixed requires a number." );
+    return { static_cast<std::conditional_t<std::is_floating_point_v<T>, T, double>>( value ), 10, 'f', precision };
+   }
+
+  // sci
+  /**
+   * @brief Function used to print a number in scientific notation (e.g. 1.50e+03 with precision 2). Integers are converted to double.
+   * 
+   * @tparam T The type of the number.
+   * @param value The number.
+   * @param precision The number of digits after the decimal point.
+   * @return Formatted<std::conditional_t<std::is_floating_point_v<T>, T, double>> The object to be printed.
+   */
+  template <class T>
+  inline Formatted<std::conditional_t<std::is_floating_point_v<T>, T, double>> sci( T value, int precision = 6 )
+   {
+    static_assert( is_number_v<T>, "ptc::sci requires a number." );
+    return { static_cast<std::conditional_t<std::is_floating_point_v<T>, T, double>>( value ), 10, 'e', precision };
+   }
+
+  // pad
+  /**
+   * @brief Function used to print a number (possibly formatted with ptc::hex, ptc::fixed...) right-aligned in a field of a given width. If the fill char is '0' it is inserted after the sign. For example: ptc::pad( ptc::hex( 255 ), 4, '0' ) is printed as 00ff.
+   * 
+   * @tparam T The type of the number.
+   * @param value The number.
+   * @param width The minimum width of the field.
+   * @param fill The char used to fill the field.
+   * @return Padded<T> The object to be printed.
+   */
+  template <class T, std::enable_if_t<! std::is_convertible_v<const T&, std::string_view>, int> = 0>
+  inline Padded<T> pad( T value, std::size_t width, char fill = ' ' )
+   {
+    static_assert( is_number_v<T> || is_formatted<T>::value, "ptc::pad requires a number, a formatted number or a string." );
+    return { value, width, fill };
+   }
+
+  /**
+   * @brief Function used to print a string right-aligned in a field of a given width.
+   * 
+   * @param value The string.
+   * @param width The minimum width of the field.
+   * @param fill The char used to fill the field.
+   * @return Padded<std::string_view> The object to be printed.
+   */
+  inline Padded<std::string_view> pad( std::string_view value, std::size_t width, char fill = ' ' )
+   {
+    return { value, width, fill };
+   }
+
+  inline namespace detail
+   {
+    // format_integer
+    /**
+     * @brief Function used to write an integer in a given base into a char buffer. Negative integers are written with a sign in base 10 and in two's complement otherwise.
+     * 
+     * @tparam T The type of the integer.
+     * @param out The output buffer, which must hold at least 8 * sizeof( T ) + 1 chars.
+     * @param value The integer.
+     * @param base The base.
+     * @return char* The end of the written text.
+     */
+    template <class T>
+    char* format_integer( char* out, T value, int base )
+     {
+      using unsigned_type = std::make_unsigned_t<T>;
+      auto digits = static_cast<unsigned_type>( value );
+      if constexpr( std::is_signed_v<T> )
+       {
+        if ( base == 10 && value < 0 )
+         {
+          *out++ = '-';
+          digits = static_cast<unsigned_type>( unsigned_type( 0 ) - digits );
+         }
+       }
+
+      char reversed[ 8 * sizeof( T ) ];
+      char* first = reversed + sizeof( reversed );
+      const auto divisor = static_cast<unsigned_type>( base );
+      do
+       {
+        *--first = hex_digits[ digits % divisor ];
+        digits /= divisor;
+       } while( digits != 0 );
+
+      for( ; first != reversed + sizeof( reversed ); ++first ) *out++ = *first;
+      return out;
+     }
+
+    // format_value
+    /**
+     * @brief Function used to write a Formatted number into a char buffer.
+     * 
+     * @tparam T The type of the number.
+     * @param first The beginning of the buffer.
+     * @param last The end of the buffer.
+     * @param number The number and its format.
+     * @return std::size_t The number of written chars, or zero if the buffer is too small.
+     */
+    template <class T>
+    std::size_t format_value( char* first, char* last, const Formatted<T>& number )
+     {
+      if constexpr( std::is_integral_v<T> )
+       {
+        if ( last - first <= static_cast<std::ptrdiff_t>( 8 * sizeof( T ) ) ) return 0;
+        return static_cast<std::size_t>( format_integer( first, number.value, number.base ) - first );
+       }
+      else
+       {
+        #ifdef PTC_HAS_TO_CHARS
+        const std::chars_format format = number.style == 'f' ? std::chars_format::fixed : number.style == 'e' ? std::chars_format::scientific :
+                                         number.style == 'a' ? std::chars_format::hex : std::chars_format::general;
+        const std::to_chars_result result = number.precision < 0 ? std::to_chars( first, last, number.value, format ) : 
+                                                                   std::to_chars( first, last, number.value, format, number.precision );
+        return result.ec == std::errc() ? static_cast<std::size_t>( result.ptr - first ) : 0;
+        #else
+        char pattern[] = { '%', '.', '*', 'L', number.style, '\0' };
+        const int precision = number.precision < 0 ? ( number.style == 'a' ? -1 : 17 ) : number.precision;
+        const int size = std::snprintf( first, static_cast<std::size_t>( last - first ), pattern, precision, static_cast<long double>( number.value ) );
+        if ( size < 0 || size >= last - first ) return 0;
+        if ( number.style != 'a' ) return static_cast<std::size_t>( size );
+
+        // Removing the "0x" prefix, which std::to_chars doesn't write
+        char* prefix = first + ( *first == '-' ? 1 : 0 );
+        std::memmove( prefix, prefix + 2, static_cast<std::size_t>( first + size - prefix - 2 ) );
+        return static_cast<std::size_t>( size - 2 );
+        #endif
+       }
+     }
+
+    // with_text
+    /**
+     * @brief Function used to format a value into a stack buffer (or a heap buffer for very long numbers, such as 1e300 in fixed notation) and pass the text to a function.
+     * 
+     * @tparam T The type of the value.
+     * @tparam Function The type of the function.
+     * @param value The value (a number, a Formatted number or a string).
+     * @param function The function, called with the data and the size of the text.
+     */
+    template <class T, class Function>
+    void with_text( const T& value, Function&& function )
+     {
+      if constexpr( std::is_convertible_v<const T&, std::string_view> )
+       {
+        const std::string_view text = value;
+        function( text.data(), text.size() );
+       }
+      else if constexpr( is_number_v<T> ) with_text( Formatted<T>{ value, 10, 'g', 6 }, function );
+      else
+       {
+        char buffer[ number_buffer_size ];
+        std::size_t size = format_value( buffer, buffer + sizeof( buffer ), value );
+        if ( size != 0 ) function( buffer, size );
+        else
+         {
+          std::string large( 4 * number_buffer_size, '\0' );
+          while( ( size = format_value( large.data(), large.data() + large.size(), value ) ) == 0 && large.size() < ( 1u << 20 ) ) large.resize( 4 * large.size() );
+          function( large.data(), size );
+         }
+       }
+     }
+
+    // write_fill
+    /**
+     * @brief Function used to write a char many times to a stream.
+     * 
+     * @tparam T_str The char type of the ostream object.
+     * @param os The stream object.
+     * @param fill The char.
+     * @param count The number of times the char is written.
+     */
+    template <class T_str>
+    void write_fill( std::basic_ostream<T_str>& os, char fill, std::size_t count )
+     {
+      T_str chunk[ 64 ];
+      for( T_str& ch: chunk ) ch = static_cast<T_str>( fill );
+      for( ; count > 64; count -= 64 ) os.write( chunk, 64 );
+      os.write( chunk, static_cast<std::streamsize>( count ) );
+     }
+   }
+
+  // Overload for formatted numbers printing
+  /**
+   * @brief Operator << overload for formatted numbers printing. The stream settings are neither used nor modified.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @tparam T The type of the number.
+   * @param os The stream to which the number is printed to.
+   * @param number The number and its format.
+   * @return std::basic_ostream<T_str>& The stream to which the number is printed to.
+   */
+  template <class T_str, class T>
+  std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const Formatted<T>& number )
+   {
+    with_text( number, [ &os ]( const char* data, std::size_t size ){ write_ascii( os, data, size ); } );
+
+    return os;
+   }
+
+  // Overload for padded values printing
+  /**
+   * @brief Operator << overload for padded values printing. The stream settings are neither used nor modified.
+   * 
+   * @tparam T_str The char type of the ostream object.
+   * @tparam T The type of the value.
+   * @param os The stream to which the value is printed to.
+   * @param padded The value, the width and the fill char.
+   * @return std::basic_ostream<T_str>& The stream to which the value is printed to.
+   */
+  template <class T_str, class T>
+  std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const Padded<T>& padded )
+   {
+    with_text( padded.value, [ &os, &padded ]( const char* data, std::size_t size )
+     {
+      const std::size_t count = padded.width > size ? padded.width - size : 0;
+      if ( count != 0 && padded.fill == '0' && size != 0 && ( *data == '-' || *data == '+' ) )
+       {
+        write_ascii( os, data, 1 );
+        ++data;
+        --size;
+       }
+      write_fill( os, padded.fill, count );
+      write_ascii( os, data, size );
+     } );
+
+    return os;
+   }
+
+  //====================================================
+  //     FastStreambuf class
+  //====================================================
+  /**
+   * @brief Stream buffer which writes directly to a file descriptor through a large buffer. Output is flushed at each newline if the descriptor is a terminal (so that interactive output stays usable) and only when the buffer is full otherwise. Like any std::streambuf it is not synchronized: concurrent writers must be serialized (ptc::print already does it).
+   * 
+   */
+  class FastStreambuf: public std::streambuf
+   {
+    public:
+
+     //====================================================
+     //     Public constants
+     //====================================================
+     static constexpr std::size_t default_size = 1 << 16;
+     static constexpr std::size_t gather_threshold = 1 << 14;   ///< Size from which print arguments are written in place by writeGathered.
+
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Constructor
+     /**
+      * @brief Construct a new FastStreambuf object.
+      * 
+      * @param fd The file descriptor to which the output is written.
+      * @param buffer_size The size of the buffer.
+      */
+     explicit FastStreambuf( int fd, std::size_t buffer_size = default_size ):
+      fd_( fd ),
+      tty_( is_tty( fd ) ),
+      line_buffered( tty_ ),
+      buffer( buffer_size > 0 ? buffer_size : 1 )
+      {
+       reset_put_area();
+      }
+
+     // Destructor
+     /**
+      * @brief Destroy the FastStreambuf object, writing the pending output and giving back the original buffer to the stream it has been installed in.
+      * 
+      */
+     ~FastStreambuf() override
+      {
+       sync();
+       uninstall();
+      }
+
+     FastStreambuf( const FastStreambuf& ) = delete;
+     FastStreambuf& operator=( const FastStreambuf& ) = delete;
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // install
+     /**
+      * @brief Method used to make a stream write through this buffer. The previous stream buffer is restored by "uninstall" or at destruction.
+      * 
+      * @param os The stream.
+      */
+     void install( std::ostream& os )
+      {
+       if ( installed == &os ) return;
+       uninstall();
+       os.flush();
+       previous = os.rdbuf( this );
+       installed = &os;
+      }
+
+     // uninstall
+     /**
+      * @brief Method used to restore the original buffer of the stream this buffer has been installed in.
+      * 
+      */
+     void uninstall()
+      {
+       if ( ! installed ) return;
+       sync();
+       installed -> rdbuf( previous );
+       installed = nullptr;
+       previous = nullptr;
+      }
+
+     // setBufferSize
+     /**
+      * @brief Method used to change the size of the buffer. Pending output is written first.
+      * 
+      * @param buffer_size The new size of the buffer.
+      */
+     void setBufferSize( std::size_t buffer_size )
+      {
+       sync();
+       buffer.assign( buffer_size > 0 ? buffer_size : 1, '\0' );
+       reset_put_area();
+      }
+
+     // setLineBuffered
+     /**
+      * @brief Method used to force flushing at each newline (true) or only when the buffer is full (false), instead of choosing it from the terminal detection.
+      * 
+      * @param line_buffered_val The line buffering flag.
+      */
+     void setLineBuffered( bool line_buffered_val )
+      {
+       sync();
+       line_buffered = line_buffered_val;
+       reset_put_area();
+      }
+
+     // writeGathered
+     /**
+      * @brief Method used to write the pending output followed by a sequence of pieces with a single system call (writev), without copying the pieces into the buffer. On Windows the pieces are written one after the other.
+      * 
+      * @param pieces The pieces.
+      * @param count The number of pieces.
+      * @return true If everything has been written.
+      * @return false Otherwise.
+      */
+     bool writeGathered( const std::string_view* pieces, std::size_t count )
+      {
+       #if defined( _WIN32 )
+       bool done = sync() == 0;
+       for( std::size_t i = 0; i < count && done; ++i ) done = write_all( pieces[i].data(), pieces[i].size() );
+       return done;
+       #else
+       constexpr std::size_t max_iov = 64;
+       iovec iov[ max_iov ];
+       std::size_t n = 0;
+       bool done = true;
+       if ( pending() > 0 ) iov[ n++ ] = { buffer.data(), pending() };
+       for( std::size_t i = 0; i < count && done; ++i )
+        {
+         if ( pieces[i].empty() ) continue;
+         iov[ n++ ] = { const_cast<char*>( pieces[i].data() ), pieces[i].size() };
+         if ( n == max_iov )
+          {
+           done = writev_all( iov, n );
+           n = 0;
+          }
+        }
+       if ( done && n > 0 ) done = writev_all( iov, n );
+       used = 0;
+       reset_put_area();
+       return done;
+       #endif
+      }
+
+     // isTTY
+     /**
+      * @brief Method used to know if the file descriptor is a terminal.
+      * 
+      * @return true If the file descriptor is a terminal.
+      * @return false Otherwise.
+      */
+     bool isTTY() const { return tty_; }
+
+     // fd
+     /**
+      * @brief Method used to get the file descriptor of the buffer.
+      * 
+      * @return int The file descriptor.
+      */
+     int fd() const { return fd_; }
+
+    protected:
+
+     //====================================================
+     //     Protected methods
+     //====================================================
+
+     // overflow
+     int_type overflow( int_type c ) override
+      {
+       if ( traits_type::eq_int_type( c, traits_type::eof() ) ) return sync() == 0 ? traits_type::not_eof( c ) : traits_type::eof();
+
+       // Without a put area (line buffering) each char reaches this method
+       if ( line_buffered )
+        {
+         if ( used == buffer.size() && sync() != 0 ) return traits_type::eof();
+         buffer[ used++ ] = traits_type::to_char_type( c );
+         if ( traits_type::to_char_type( c ) == '\n' || used == buffer.size() )
+          {
+           if ( sync() != 0 ) return traits_type::eof();
+          }
+         return c;
+        }
+       if ( sync() != 0 ) return traits_type::eof();
+       *pptr() = traits_type::to_char_type( c );
+       pbump( 1 );
+       return c;
+      }
+
+     // xsputn
+     std::streamsize xsputn( const char* s, std::streamsize n ) override
+      {
+       const std::size_t size = static_cast<std::size_t>( n );
+
+       // Large chunks are written directly, without being copied into the buffer
+       if ( size >= buffer.size() )
+        {
+         if ( sync() != 0 || ! write_all( s, size ) ) return 0;
+         return n;
+        }
+       if ( size > buffer.size() - pending() && sync() != 0 ) return 0;
+       std::copy( s, s + size, buffer.data() + pending() );
+       if ( line_buffered ) used += size;
+       else pbump( static_cast<int>( size ) );
+       if ( line_buffered && ( used == buffer.size() || std::char_traits<char>::find( s, size, '\n' ) ) && sync() != 0 ) return 0;
+
+       return n;
+      }
+
+     // sync
+     int sync() override
+      {
+       const bool done = write_all( buffer.data(), pending() );
+       used = 0;
+       reset_put_area();
+       return done ? 0 : -1;
+      }
+
+    private:
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // pending
+     std::size_t pending() const
+      {
+       return line_buffered ? used : static_cast<std::size_t>( pptr() - pbase() );
+      }
+
+     // reset_put_area
+     void reset_put_area()
+      {
+       if ( line_buffered ) setp( nullptr, nullptr );
+       else setp( buffer.data(), buffer.data() + buffer.size() );
+      }
+
+     // write_all
+     bool write_all( const char* data, std::size_t size ) const
+      {
+       while( size > 0 )
+        {
+         #if defined( _WIN32 )
+         const int written = _write( fd_, data, static_cast<unsigned int>( size ) );
+         #else
+         const ssize_t written = ::write( fd_, data, size );
+         if ( written < 0 && errno == EINTR ) continue;
+         #endif
+         if ( written <= 0 ) return false;
+         data += written;
+         size -= static_cast<std::size_t>( written );
+        }
+       return true;
+      }
+
+     #if ! defined( _WIN32 )
+
+     // writev_all
+     bool writev_all( iovec* iov, std::size_t count ) const
+      {
+       while( count > 0 )
+        {
+         const ssize_t written = ::writev( fd_, iov, static_cast<int>( count ) );
+         if ( written < 0 && errno == EINTR ) continue;
+         if ( written <= 0 ) return false;
+
+         // Skipping what has been written, in case of partial writes
+         std::size_t left = static_cast<std::size_t>( written );
+         while( count > 0 && left >= iov -> iov_len )
+          {
+           left -= iov -> iov_len;
+           ++iov;
+           --count;
+          }
+         if ( count > 0 )
+          {
+           iov -> iov_base = static_cast<char*>( iov -> iov_base ) + left;
+           iov -> iov_len -= left;
+          }
+        }
+       return true;
+      }
+
+     #endif
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     int fd_;
+     bool tty_, line_buffered;
+     std::vector<char> buffer;
+     std::size_t used = 0;
+     std::ostream* installed = nullptr;
+     std::streambuf* previous = nullptr;
+   };
+
+  // fast_stdout
+  /**
+   * @brief Function used to get the FastStreambuf object which writes to the standard output (file descriptor 1). It is created at its first usage.
+   * 
+   * @return FastStreambuf& The standard output buffer.
+   */
+  inline FastStreambuf& fast_stdout()
+   {
+    static FastStreambuf buffer( 1 );
+    return buffer;
+   }
+
+  // fast_stderr
+  /**
+   * @brief Function used to get the FastStreambuf object which writes to the standard error (file descriptor 2). It is created at its first usage.
+   * 
+   * @return FastStreambuf& The standard error buffer.
+   */
+  inline FastStreambuf& fast_stderr()
+   {
+    static FastStreambuf buffer( 2 );
+    return buffer;
+   }
+
+  inline namespace detail
+   {
+    // append_utf8
+    /**
+     * @brief Function used to write the UTF-8 encoding of a code point. Surrogates and values out of the Unicode range are written as U+FFFD.
+     * 
+     * @param out The output position.
+     * @param cp The code point.
+     * @return char* The position after the written bytes.
+     */
+    inline char* append_utf8( char* out, char32_t cp )
+     {
+      if ( ( cp >= 0xd800 && cp <= 0xdfff ) || cp > 0x10ffff ) cp = 0xfffd;
+      if ( cp < 0x80 ) *out++ = static_cast<char>( cp );
+      else if ( cp < 0x800 )
+       {
+        *out++ = static_cast<char>( 0xc0 | ( cp >> 6 ) );
+        *out++ = static_cast<char>( 0x80 | ( cp & 0x3f ) );
+       }
+      else if ( cp < 0x10000 )
+       {
+        *out++ = static_cast<char>( 0xe0 | ( cp >> 12 ) );
+        *out++ = static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3f ) );
+        *out++ = static_cast<char>( 0x80 | ( cp & 0x3f ) );
+       }
+      else
+       {
+        *out++ = static_cast<char>( 0xf0 | ( cp >> 18 ) );
+        *out++ = static_cast<char>( 0x80 | ( ( cp >> 12 ) & 0x3f ) );
+        *out++ = static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3f ) );
+        *out++ = static_cast<char>( 0x80 | ( cp & 0x3f ) );
+       }
+      return out;
+     }
+
+    // encode_utf8
+    /**
+     * @brief Function used to encode a text to UTF-8: char8_t text is copied, 2 bytes code units (char16_t and wchar_t on Windows) are decoded as UTF-16 and 4 bytes ones as UTF-32. ASCII runs are copied without decoding. A high surrogate at the end of the text is kept in "high" and paired with the first code unit of the next call. The output must have room for 4 bytes per code unit plus 3.
+     * 
+     * @tparam T_str The char type of the text.
+     * @param data The text.
+     * @param size The size of the text.
+     * @param out The output.
+     * @param high The pending high surrogate (0 if none).
+     * @return char* The position after the written bytes.
+     */
+    template <class T_str>
+    char* encode_utf8( const T_str* data, std::size_t size, char* out, char32_t& high )
+     {
+      if constexpr( sizeof( T_str ) == 1 )
+       {
+        std::char_traits<char>::copy( out, reinterpret_cast<const char*>( data ), size );
+        return out + size;
+       }
+      else
+       {
+        const T_str* last = data + size;
+        while( data != last )
+         {
+          if ( high == 0 )
+           {
+            while( data != last && static_cast<char32_t>( *data ) < 0x80 ) *out++ = static_cast<char>( *data++ );
+            if ( data == last ) break;
+           }
+          char32_t cp = static_cast<char32_t>( *data++ );
+          if constexpr( sizeof( T_str ) == 2 )
+           {
+            if ( high != 0 && cp >= 0xdc00 && cp <= 0xdfff )
+             {
+              cp = 0x10000 + ( ( high - 0xd800 ) << 10 ) + ( cp - 0xdc00 );
+              high = 0;
+             }
+            else
+             {
+              if ( high != 0 ) out = append_utf8( out, 0xfffd );
+              high = 0;
+              if ( cp >= 0xd800 && cp <= 0xdbff )
+               {
+                high = cp;
+                continue;
+               }
+             }
+           }
+          out = append_utf8( out, cp );
+         }
+        return out;
+       }
+     }
+   }
+
+  //====================================================
+  //     Utf8Streambuf class
+  //====================================================
+  /**
+   * @brief Stream buffer which encodes the text of a non-char stream (char8_t, char16_t, char32_t or wchar_t) to UTF-8 and writes the bytes to a char stream or to a file descriptor. The encoding does not depend on the global locale; text is converted in chunks through a stack buffer and invalid code units are written as U+FFFD. Like any std::streambuf it is not synchronized.
+   * 
+   * @tparam T_str The char type of the text.
+   */
+  template <class T_str>
+  class Utf8Streambuf: public std::basic_streambuf<T_str>
+   {
+    static_assert( ! std::is_same_v<T_str, char>, "Utf8Streambuf is meant for non-char streams" );
+
+    public:
+
+     using typename std::basic_streambuf<T_str>::int_type;
+     using typename std::basic_streambuf<T_str>::traits_type;
+
+     //====================================================
+     //     Public constructors
+     //====================================================
+
+     // Constructor (char stream)
+     /**
+      * @brief Construct a new Utf8Streambuf object which writes the bytes to a char stream (e.g. std::cout, whose current buffer is used at each write).
+      * 
+      * @param sink The char stream.
+      */
+     explicit Utf8Streambuf( std::ostream& sink ): sink_( &sink ) {}
+
+     // Constructor (file descriptor)
+     /**
+      * @brief Construct a new Utf8Streambuf object which writes the bytes to a file descriptor, through its own FastStreambuf.
+      * 
+      * @param fd The file descriptor.
+      * @param buffer_size The size of the bytes buffer.
+      */
+     explicit Utf8Streambuf( int fd, std::size_t buffer_size = FastStreambuf::default_size ):
+      owned( std::make_unique<Owned>( fd, buffer_size ) ),
+      sink_( &owned -> stream )
+      {}
+
+     Utf8Streambuf( const Utf8Streambuf& ) = delete;
+     Utf8Streambuf& operator=( const Utf8Streambuf& ) = delete;
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // sink
+     /**
+      * @brief Method used to get the char stream to which the bytes are written.
+      * 
+      * @return std::ostream& The char stream.
+      */
+     std::ostream& sink() const { return *sink_; }
+
+    protected:
+
+     //====================================================
+     //     Protected methods
+     //====================================================
+
+     // overflow
+     int_type overflow( int_type c ) override
+      {
+       if ( traits_type::eq_int_type( c, traits_type::eof() ) ) return sync() == 0 ? traits_type::not_eof( c ) : traits_type::eof();
+       const T_str ch = traits_type::to_char_type( c );
+       return write( &ch, 1 ) ? c : traits_type::eof();
+      }
+
+     // xsputn
+     std::streamsize xsputn( const T_str* s, std::streamsize n ) override
+      {
+       return write( s, static_cast<std::size_t>( n ) ) ? n : 0;
+      }
+
+     // sync
+     int sync() override
+      {
+       sink_ -> flush();
+       return sink_ -> good() ? 0 : -1;
+      }
+
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+     struct Owned
+      {
+       FastStreambuf buffer;
+       std::ostream stream;
+
+       Owned( int fd, std::size_t buffer_size ): buffer( fd, buffer_size ), stream( &buffer ) {}
+      };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // write
+     bool write( const T_str* data, std::size_t size )
+      {
+       char bytes[ chunk * 4 + 3 ];
+       while( size > 0 )
+        {
+         const std::size_t n = size < chunk ? size : chunk;
+         const char* end = encode_utf8( data, n, bytes, high );
+         sink_ -> write( bytes, end - bytes );
+         data += n;
+         size -= n;
+        }
+       return sink_ -> good();
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     static constexpr std::size_t chunk = 256;
+     std::unique_ptr<Owned> owned;
+     std::ostream* sink_;
+     char32_t high = 0;
+   };
+
+  // utf8_stdout
+  /**
+   * @brief Function used to get a stream which writes its text to std::cout encoded to UTF-8 (see Utf8Streambuf). It is the default stream of the char8_t, char16_t and char32_t Print objects and can be given to ptc::wprint to bypass std::wcout and its locale. It is created at its first usage.
+   * 
+   * @tparam T_str The char type of the stream.
+   * @return std::basic_ostream<T_str>& The stream.
+   */
+  template <class T_str>
+  std::basic_ostream<T_str>& utf8_stdout()
+   {
+    static Utf8Streambuf<T_str> buffer( std::cout );
+    static std::basic_ostream<T_str> stream( &buffer );
+    return stream;
+   }
+
+  inline namespace detail
+   {
+    // StandardSinks
+    /**
+     * @brief Struct used to store the buffers that the standard streams had at program startup.
+     * 
+     */
+    struct StandardSinks
+     {
+      const void* streams[ 6 ] = { &std::cout, &std::cerr, &std::clog, &std::wcout, &std::wcerr, &std::wclog };
+      const void* buffers[ 6 ] = { std::cout.rdbuf(), std::cerr.rdbuf(), std::clog.rdbuf(), std::wcout.rdbuf(), std::wcerr.rdbuf(), std::wclog.rdbuf() };
+     };
+
+    // standard_sinks
+    /**
+     * @brief Function used to get the StandardSinks object. It is created at its first usage.
+     * 
+     * @return const StandardSinks& The standard sinks.
+     */
+    inline const StandardSinks& standard_sinks()
+     {
+      static const StandardSinks sinks;
+      return sinks;
+     }
+
+    // Recording the standard streams buffers before they can be redirected: it only reads six pointers
+    inline const StandardSinks& startup_sinks = standard_sinks();
+
+    // standard_terminal
+    /**
+     * @brief Function used to check if the standard output (fd 1) or error (fd 2) is a terminal. The check is done at the first usage.
+     * 
+     * @param fd The file descriptor (1 or 2).
+     * @return true If it is a terminal.
+     * @return false Otherwise.
+     */
+    inline bool standard_terminal( int fd )
+     {
+      static const bool terminals[ 2 ] = { is_tty( 1 ), is_tty( 2 ) };
+      return terminals[ fd == 1 ? 0 : 1 ];
+     }
+
+    // is_terminal_sink
+    /**
+     * @brief Function used to check if a stream writes to a terminal. A standard stream is a terminal if its file descriptor is, a FastStreambuf if its own file descriptor is, a Utf8Streambuf if its char stream is and a file stream is never. Streams whose destination is unknown (e.g. string streams or standard streams redirected to another buffer) are treated as terminals, so that they are left untouched.
+     * 
+     * @tparam T_str The char type of the stream.
+     * @param os The stream.
+     * @return true If the stream writes to a terminal or its destination is unknown.
+     * @return false Otherwise.
+     */
+    template <class T_str>
+    bool is_terminal_sink( const std::basic_ostream<T_str>& os )
+     {
+      const StandardSinks& sinks = standard_sinks();
+      const std::basic_streambuf<T_str>* buffer = os.rdbuf();
+      for( std::size_t i = 0; i < 6; ++i )
+       {
+        if ( sinks.streams[ i ] == &os && sinks.buffers[ i ] == buffer ) return standard_terminal( i % 3 == 0 ? 1 : 2 );
+       }
+
+      if constexpr( std::is_same_v<T_str, char> )
+       {
+        if ( const auto fast = dynamic_cast<const FastStreambuf*>( buffer ) ) return fast -> isTTY();
+       }
+      else
+       {
+        if ( const auto utf8 = dynamic_cast<const Utf8Streambuf<T_str>*>( buffer ) ) return is_terminal_sink( utf8 -> sink() );
+       }
+      if ( is_standard_stream( &os ) ) return true;
+      return dynamic_cast<const std::basic_filebuf<T_str>*>( buffer ) == nullptr;
+     }
+
+    // skip_escape
+    /**
+     * @brief Function used to skip an ANSI escape sequence: a CSI sequence (e.g. "\033[31m"), an OSC sequence (e.g. a hyperlink, terminated by BEL or by "\033\\") or a two chars sequence.
+     * 
+     * @tparam T_str The char type of the text.
+     * @param first The char after the escape char.
+     * @param last The end of the text.
+     * @return const T_str* The first char after the sequence.
+     */
+    template <class T_str>
+    const T_str* skip_escape( const T_str* first, const T_str* last )
+     {
+      if ( first == last ) return last;
+      if ( *first == T_str( '[' ) )
+       {
+        ++first;
+        while( first != last && *first >= T_str( 0x20 ) && *first <= T_str( 0x3f ) ) ++first;
+        return first != last && *first >= T_str( 0x40 ) && *first <= T_str( 0x7e ) ? first + 1 : first;
+       }
+      if ( *first == T_str( ']' ) )
+       {
+        for( ++first; first != last; ++first )
+         {
+          if ( *first == T_str( '\a' ) ) return first + 1;
+          if ( *first == T_str( '\033' ) && first + 1 != last && first[ 1 ] == T_str( '\\' ) ) return first + 2;
+         }
+        return last;
+       }
+      return first + 1;
+     }
+
+    // strip_escapes
+    /**
+     * @brief Function used to remove the ANSI escape sequences from a text, in place. Escape chars are searched with std::char_traits::find (memchr for chars, which is vectorized by the C library), so text without sequences is only scanned.
+     * 
+     * @tparam T_str The char type of the text.
+     * @param data The text.
+     * @param size The size of the text.
+     * @return std::size_t The size of the text without the escape sequences.
+     */
+    template <class T_str>
+    std::size_t strip_escapes( T_str* data, std::size_t size )
+     {
+      using traits = std::char_traits<T_str>;
+      const T_str* last = data + size;
+      const T_str* next = traits::find( data, size, T_str( '\033' ) );
+      if ( ! next ) return size;
+
+      T_str* out = const_cast<T_str*>( next );
+      while( next )
+       {
+        const T_str* first = skip_escape( next + 1, last );
+        next = traits::find( first, static_cast<std::size_t>( last - first ), T_str( '\033' ) );
+        const T_str* stop = next ? next : last;
+        traits::move( out, first, static_cast<std::size_t>( stop - first ) );
+        out += stop - first;
+       }
+      return static_cast<std::size_t>( out - data );
+     }
+   }
+
+  // set_thread_name
+  /**
+   * @brief Function used to set the name of the calling thread, written as line prefix by the Print objects with an enabled thread prefix. An empty name restores the thread id. Only ASCII names are supported by non-char Print objects.
+   * 
+   * @param name The thread name.
+   */
+  template <class = void>
+  inline void set_thread_name( const std::string& name )
+   {
+    ThreadName& current = thread_name();
+    current.name = name;
+    ++current.generation;
+   }
+
+  //====================================================
+  //     ptc_print class
+  //====================================================
+  /**
+   * @brief Class used to construct the print function.
+   * 
+   * @tparam T_str The type of the string objects defined inside the struct. This template is used in case you are dealing with std::string or std::wstring objects.
+   */
+  template <class T_str>
+  struct Print
+   {
+    //====================================================
+    //     Public types
+    //====================================================
+
+    // Hook
+    /**
+     * @brief Type of the functions which can be registered as pre-write or post-write hooks.
+     * 
+     */
+    using Hook = std::function<void( const PrintEvent<T_str>& )>;
+
+    //====================================================
+    //     Public constructors and destructor
+    //====================================================
+
+    // Default constructor
+    /**
+     * @brief Default constructor of the Print class. It only initializes the basic class members (constexpr if PTC_HAS_CONSTINIT is defined, so that the global objects are constant-initialized); the performance improvements and the fast streams (if enabled) are set once at startup, by detail::standard_streams_setup.
+     * 
+     */
+    PTC_CONSTEXPR explicit Print(): 
+     end( 1, T_str( '\n' ) ),
+     sep( 1, T_str( ' ' ) ),
+     flush( false )
+     {}
+
+    // Destructor
+    /**
+     * @brief Destroy the Print object, writing the lines still queued by the asynchronous printing and the pending "last message repeated" line.
+     * 
+     */
+    ~Print()
+     {
+      stop_async();
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      if ( dedup_stream ) write_repeats();
+     }
+
+    //====================================================
+    //     Public structs
+    //====================================================
+
+    // select_cout
+    /**
+     * @brief Struct used to define a way to template the choice of the "std::cout" object in order to be "std::cout" for "char" type or "std::wcout" for "wchar_t" type.
+     * 
+     * @tparam T The template type of the "std::cout" object (char, wchar_t, ...).
+     */  
+    template <class T> 
+    struct select_cout
+     {
+      static std::basic_ostream<T> &cout;
+     };
+
+    #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
+   
+    // select_cin
+    /**
+     * @brief Struct used to define a way to template the choice of the "std::cin" object in order to be "std::cin" for "char" type or "std::wcin" for "wchar_t" type.
+     * 
+     * @tparam T The template type of the "std::cin" object (char, wchar_t, ...).
+     */  
+    template <class T> 
+    struct select_cin
+     {
+      static std::basic_istream<T> &cin;
+     };
+  
+    #endif
+
+    //====================================================
+    //     Public setters
+    //====================================================
+
+    // setEnd
+    /**
+     * @brief Setter used to set the value of the "end" variable. Templated type is required in order to allow also char variables.
+     * 
+     * @tparam T The type of the expression inserted to set the value of "end" variable.
+     * @param end_val The inserted expression used to set the value of "end" variable.
+     */
+    template <class T> 
+    inline void setEnd( const T& end_val )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      end = end_val;
+      changed();
+     }
+
+    // setSep
+    /**
+     * @brief Setter used to set the value of the "sep" variable. Templated type is required in order to allow also char variables.
+     * 
+     * @tparam T The type of the expression inserted to set the value of "sep" variable.
+     * @param end_val The inserted expression used to set the value of "sep" variable.
+     */
+    template <class T>
+    inline void setSep( const T& sep_val )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      sep = sep_val;
+      changed();
+     }
+
+    // setFlush
+    /**
+     * @brief Setter used to set the value of the "flush" variable. Templated type is required in order to allow also char variables.
+     * 
+     * @param flush_val The inserted expression used to set the value of the "flush" variable.
+     */
+    inline void setFlush( const bool& flush_val )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      flush = flush_val;
+     }
+
+    // setFlushPolicy
+    /**
+     * @brief Setter used to set the flush policy, which decides when to flush the streams if the "flush" variable is false. Each enabled condition can trigger a flush; conditions are checked when a line is written.
+     * 
+     * @param policy_val The flush policy.
+     */
+    inline void setFlushPolicy( const FlushPolicy& policy_val )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      flush_policy = policy_val;
+      lines_since_flush = 0;
+      bytes_since_flush = 0;
+      last_flush = std::chrono::steady_clock::time_point{};
+      changed();
+     }
+
+    // setThreadPrefix
+    /**
+     * @brief Setter used to prefix each printed line with the name of the printing thread (see ptc::set_thread_name), or with its id if unnamed, followed by the "sep" variable. The prefix is preformatted once per thread, so it costs a single copy per line. Lines returned by the "mode::str" mode are never prefixed.
+     * 
+     * @param thread_prefix_val The value of the thread prefix flag.
+     */
+    inline void setThreadPrefix( const bool& thread_prefix_val )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      thread_prefix_ = thread_prefix_val;
+      changed();
+     }
+
+    // setTimestamp
+    /**
+     * @brief Setter used to prefix each printed line with a timestamp, followed by the "sep" variable. The format follows the std::strftime syntax, plus "%f" (microseconds) or "%Nf" (N sub-second digits, with N from 1 to 9) for the first fractional part. The date and time are rendered once per second and per thread, while the sub-second digits are rewritten at each call. An empty format disables the timestamp. Lines returned by the "mode::str" mode are never prefixed.
+     * 
+     * @param format The timestamp format (for example "%Y-%m-%d %H:%M:%S.%3f").
+     * @param zone The time zone of the timestamp.
+     */
+    inline void setTimestamp( const std::string& format, time_zone zone = time_zone::local )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      timestamp_head = format;
+      timestamp_tail.clear();
+      timestamp_digits = 0;
+      timestamp_zone = zone;
+      timestamp_id_ = format.empty() ? 0 : timestamp_id();
+
+      // Splitting the format at the first sub-second field
+      for( std::size_t i = 0; i + 1 < format.size(); ++i )
+       {
+        if ( format[i] != '%' ) continue;
+        std::size_t digits = 6, length = 2;
+        if ( format[i + 1] >= '1' && format[i + 1] <= '9' && i + 2 < format.size() && format[i + 2] == 'f' )
+         {
+          digits = static_cast<std::size_t>( format[i + 1] - '0' );
+          length = 3;
+         }
+        else if ( format[i + 1] != 'f' )
+         {
+          ++i; // Skipping the conversion specifier (e.g. "%%")
+          continue;
+         }
+        timestamp_head = format.substr( 0, i );
+        timestamp_tail = format.substr( i + length );
+        timestamp_digits = digits;
+        break;
+       }
+      changed();
+     }
+    
+    // setDeduplication
+    /**
+     * @brief Setter used to suppress consecutive duplicate lines written to the standard streams (std::cout, std::cerr, std::clog and their wide versions), whose pending report can be written at any later time; lines written to other streams are never suppressed. Each line is hashed (prefixes excluded) and, if it is equal to the last line written to the same stream less than "window" ago, it is only counted. The count is reported with a single "last message repeated N times" line before the next different line, or before the same line once the window has expired. The pending report is written by this setter too; a zero window disables the suppression. Lines returned by the "mode::str" mode are never suppressed.
+     * 
+     * @param window The time window in which duplicates of a written line are suppressed.
+     */
+    inline void setDeduplication( std::chrono::milliseconds window )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      if ( dedup_stream ) write_repeats();
+      dedup_window = window;
+      dedup_stream = nullptr;
+      changed();
+     }
+    
+    // setTTY
+    /**
+     * @brief Setter used to choose if the streams are treated as terminals. With tty::automatic (the default) each stream is checked: the standard streams and the FastStreambuf objects through their file descriptor, while file streams are never terminals. Lines written to a stream which is not a terminal are stripped of ANSI escape sequences (including the automatic reset). Flushes are not affected: the ones requested with setFlush or setFlushPolicy apply to every stream, while without them lines are flushed only when the stream buffer is full. Lines returned by the "mode::str" mode are never stripped.
+     * 
+     * @param mode tty::automatic to detect terminals, tty::always or tty::never to force either behavior on all the streams.
+     */
+    inline void setTTY( tty mode )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      tty_mode = mode;
+      changed();
+     }
+
+    // setPattern
+    /**
+     * @brief Setter used to set the value of the "pattern" variable. Templated type is required in order to allow also char variables.
+     * 
+     * @tparam T The type of the expression inserted to set the value of "pattern" variable.
+     * @param pattern_val The inserted expression used to set the value of "pattern" variable.
+     */
+    template <class T>
+    inline void setPattern( const T& pattern_val )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      pattern = pattern_val;
+      changed();
+     }
+
+    // installFastStreams
+    /**
+     * @brief Method used to make std::cout and std::cerr write through the ptc::fast_stdout() and ptc::fast_stderr() buffers, so that printing to them bypasses the default stream buffers. Called automatically at startup if PTC_ENABLE_FAST_STREAMS is defined.
+     * 
+     * @param buffer_size The size of each buffer.
+     */
+    inline void installFastStreams( std::size_t buffer_size = FastStreambuf::default_size ) const
+     {
+      static_assert( std::is_same_v<T_str, char>, "Fast streams are available only for char streams." );
+      std::lock_guard <std::mutex> lock{ mutex_ };
+
+      fast_stdout().setBufferSize( buffer_size );
+      fast_stderr().setBufferSize( buffer_size );
+      fast_stdout().install( std::cout );
+      fast_stderr().install( std::cerr );
+     }
+
+    //====================================================
+    //     Public hooks methods
+    //====================================================
+
+    // addPreWriteHook
+    /**
+     * @brief Method used to register a function which is called for each formatted line, before the mutex is taken and the line is written. Lines already being printed by other threads keep the hooks they started with.
+     * 
+     * @param hook The function to be called. It receives the target stream, the number of bytes and the formatting time of the line.
+     */
+    inline void addPreWriteHook( Hook hook )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      pre_hooks.push_back( std::make_shared<const Hook>( std::move( hook ) ) );
+      changed();
+     }
+
+    // addPostWriteHook
+    /**
+     * @brief Method used to register a function which is called for each line after it has been written and the mutex has been released. Lines already being printed by other threads keep the hooks they started with.
+     * 
+     * @param hook The function to be called. It receives the target stream, the number of bytes and all the timings of the line.
+     */
+    inline void addPostWriteHook( Hook hook )
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      post_hooks.push_back( std::make_shared<const Hook>( std::move( hook ) ) );
+      changed();
+     }
+
+    // clearHooks
+    /**
+     * @brief Method used to remove all the registered pre-write and post-write hooks.
+     * 
+     */
+    inline void clearHooks()
+     {
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      pre_hooks.clear();
+      post_hooks.clear();
+      changed();
+     }
+
+    //====================================================
+    //     Public table methods
+    //====================================================
+
+    // table
+    /**
+     * @brief Method used to print a table whose columns are aligned to their widest cell. Each cell is formatted only once, with the settings of the stream, into a thread-local arena while the column widths are recorded; then the padded table is built in memory and written with a single operation. Rows can be ranges or tuple-like objects (e.g. std::tuple); numbers are right-aligned and the other cells are left-aligned. Columns are separated by the "sep" variable and rows are terminated by the "end" variable. The headers, if any, are followed by a rule.
+     * 
+     * @tparam Rows The type of the range of rows.
+     * @tparam Headers The type of the range of headers.
+     * @param os The stream in which you want to print the table.
+     * @param rows The rows.
+     * @param headers The headers.
+     */
+    template <class Rows, class Headers = std::initializer_list<std::basic_string_view<T_str>>>
+    void table( std::basic_ostream<T_str>& os, const Rows& rows, const Headers& headers = {} ) const
+     {
+      // Formatting the cells
+      TableArena<T_str>& arena = table_arena<T_str>();
+      arena.reset( os );
+      for( const auto& header: headers ) arena.add( header );
+      arena.end_row();
+      for( const auto& row: rows )
+       {
+        for_each_cell( row, [ &arena ]( const auto& cell ){ arena.add( cell ); } );
+        arena.end_row();
+       }
+
+      // Building the padded table
+      const auto config = this -> config();
+      std::size_t first = arena.row_ends[0];
+      if ( first > 0 )
+       {
+        arena.append_row( 0, first, arena.widths, config -> sep, config -> end );
+        arena.append_rule( arena.widths, config -> sep, config -> end );
+       }
+      for( std::size_t row = 1; row < arena.row_ends.size(); ++row )
+       {
+        arena.append_row( first, arena.row_ends[row], arena.widths, config -> sep, config -> end );
+        first = arena.row_ends[row];
+       }
+
+      write_table( os, arena, *config );
+     }
+
+    // tableRow
+    /**
+     * @brief Method used to print a single table row with fixed column widths, for tables whose rows are streamed (see ptc::TableWriter). Cells are aligned as in the "table" method, but the ones wider than their column are not truncated.
+     * 
+     * @tparam Row The type of the row.
+     * @param os The stream in which you want to print the row.
+     * @param widths The widths of the columns.
+     * @param row The row (a range or a tuple-like object).
+     * @param rule If true the row is followed by a rule, as the headers of a table.
+     */
+    template <class Row>
+    void tableRow( std::basic_ostream<T_str>& os, const std::vector<std::size_t>& widths, const Row& row, bool rule = false ) const
+     {
+      TableArena<T_str>& arena = table_arena<T_str>();
+      arena.reset( os );
+      for_each_cell( row, [ &arena ]( const auto& cell ){ arena.add( cell ); } );
+      const auto config = this -> config();
+      arena.append_row( 0, arena.cells.size(), widths, config -> sep, config -> end );
+      if ( rule ) arena.append_rule( widths, config -> sep, config -> end );
+
+      write_table( os, arena, *config );
+     }
+
+    //====================================================
+    //     Public getters
+    //====================================================
+
+    #ifdef PTC_ENABLE_GETTERS_FOR_UNIT_TESTS
+
+    // getEnd
+    /**
+     * @brief Getter used to get the value of the "end" variable. Mainly used for debugging.
+     * 
+     * @return auto The value of the "end" variable.
+     */
+    inline const auto& getEnd() const 
+     {
+      return end;
+     }
+
+    // getSep
+    /**
+     * @brief Getter used to get the value of the "sep" variable. Mainly used for debugging.
+     * 
+     * @return auto The value of the "sep" variable.
+     */
+    inline const auto& getSep() const
+     {
+      return sep;
+     }
+
+    // getFlush
+    /**
+     * @brief Getter used to get the value of the "flush" variable. Mainly used for debugging.
+     * 
+     * @return bool The value of the "flush" variable.
+     */
+    inline const bool& getFlush() const
+     {
+      return flush;
+     }
+
+    // getFlushPolicy
+    /**
+     * @brief Getter used to get the value of the "flush_policy" variable. Mainly used for debugging.
+     * 
+     * @return const FlushPolicy& The value of the "flush_policy" variable.
+     */
+    inline const FlushPolicy& getFlushPolicy() const
+     {
+      return flush_policy;
+     }
+
+    // getThreadPrefix
+    /**
+     * @brief Getter used to get the value of the "thread_prefix_" variable. Mainly used for debugging.
+     * 
+     * @return bool The value of the "thread_prefix_" variable.
+     */
+    inline const bool& getThreadPrefix() const
+     {
+      return thread_prefix_;
+     }
+
+    // getDeduplication
+    /**
+     * @brief Getter used to get the value of the "dedup_window" variable. Mainly used for debugging.
+     * 
+     * @return std::chrono::milliseconds The value of the "dedup_window" variable.
+     */
+    inline std::chrono::milliseconds getDeduplication() const
+     {
+      return dedup_window;
+     }
+
+    // getTTY
+    /**
+     * @brief Getter used to get the value of the "tty_mode" variable. Mainly used for debugging.
+     * 
+     * @return tty The value of the "tty_mode" variable.
+     */
+    inline tty getTTY() const
+     {
+      return tty_mode;
+     }
+
+    // getPattern
+    /**
+     * @brief Getter used to get the value of the "pattern" variable. Mainly used for debugging.
+     * 
+     * @return auto The value of the "pattern" variable.
+     */
+    inline const auto& getPattern() const
+     {
+      return pattern;
+     }
+
+    #endif
+
+    // setAsync
+    /**
+     * @brief Method used to enable asynchronous printing: lines sent to the standard streams are formatted by the caller and queued, then written by a background thread. Lines sent to other streams are written directly. The previous queue is written before the new policy is applied; a zero capacity disables asynchronous printing. It must not be called while other threads are printing with this object.
+     * 
+     * @param policy The asynchronous printing policy.
+     */
+    void setAsync( const AsyncPolicy& policy )
+     {
+      stop_async();
+      if ( policy.capacity == 0 ) return;
+
+      auto state = std::make_unique<AsyncState<T_str>>();
+      state -> policy = policy;
+      if ( policy.on_overflow == overflow::spill )
+       {
+        state -> spill.open( policy.spill_path, std::ios::app | std::ios::binary );
+        if ( ! state -> spill ) throw std::runtime_error( "ptc::Print::setAsync: cannot open the spill file \"" + policy.spill_path + "\"." );
+       }
+      async_ = std::move( state );
+      async_ -> worker = std::thread( [ this ]{ async_loop(); } );
+     }
+
+    // drainAsync
+    /**
+     * @brief Method used to wait until all the queued lines have been written.
+     * 
+     */
+    void drainAsync() const
+     {
+      if ( ! async_ ) return;
+      std::unique_lock <std::mutex> lock{ async_ -> mutex };
+      async_ -> idle.wait( lock, [ this ]{ return async_ -> queue.empty() && ! async_ -> busy; } );
+     }
+
+    // asyncStats
+    /**
+     * @brief Method used to get a snapshot of the counters of the asynchronous printing.
+     * 
+     * @return AsyncStats The counters (all zero if asynchronous printing is disabled).
+     */
+    AsyncStats asyncStats() const
+     {
+      if ( ! async_ ) return {};
+      std::lock_guard <std::mutex> lock{ async_ -> mutex };
+      return async_ -> stats;
+     }
+
+    #ifdef PTC_ENABLE_STATS
+
+    // stats
+    /**
+     * @brief Getter used to get a snapshot of the runtime statistics of the object, aggregated among all the threads which used it. Available only if PTC_ENABLE_STATS is defined.
+     * 
+     * @return PrintStats The statistics snapshot.
+     */
+    PrintStats stats() const
+     {
+      std::lock_guard <std::mutex> lock{ stats_mutex_ };
+
+      PrintStats snapshot;
+      for( const auto& counters: stats_counters_ )
+       {
+        snapshot.calls += counters -> calls.load( std::memory_order_relaxed );
+        snapshot.bytes += counters -> bytes.load( std::memory_order_relaxed );
+        snapshot.flushes += counters -> flushes.load( std::memory_order_relaxed );
+        snapshot.ansi_resets += counters -> ansi_resets.load( std::memory_order_relaxed );
+        snapshot.lock_wait += std::chrono::nanoseconds( counters -> lock_wait.load( std::memory_order_relaxed ) );
+        snapshot.formatting += std::chrono::nanoseconds( counters -> formatting.load( std::memory_order_relaxed ) );
+        snapshot.writing += std::chrono::nanoseconds( counters -> writing.load( std::memory_order_relaxed ) );
+       }
+
+      return snapshot;
+     }
+
+    #endif
+
+    //====================================================
+    //     Public operator () overloads
+    //====================================================
+
+    // General case
+    /**
+     * @brief Frontend implementation of the () operator overload to print to the output stream. The backend implementation is called in the required variation.
+     * 
+     * @tparam T Generic type of first object to be passed as argument to the backend implementation.
+     * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
+     * @param first First object to be passed to the backend implementation.
+     * @param args The list of all the other objects to be passed to the backend implementation.
+     */
+    template <class T, class... Args>
+    void operator()( T&& first, Args&&... args ) const
+     {
+      if constexpr ( std::is_base_of_v <std::basic_ostream<T_str>, std::remove_reference_t<T>> )
        {
-        std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
-        for ( const auto& elem: container )
+        print_backend<true>( std::forward<T>( first ), std::forward<Args>( args )... );
+       }
+      else
+       {
+        print_backend<true>( default_stream(), std::forward<T>( first ), std::forward<Args>( args )... );
+       }
+     }
+
+    // String initialization case
+    /**
+     * @brief Frontend implementation of the () operator overload to initialize its content with an std::string object. The backend implementation is called in the required variation. This overload is required in order to hide the output of the "print_backend" function during the initialization.
+     * 
+     * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
+     * @param first First object to be passed to the backend implementation.
+     * @param args The list of all the other objects to be passed to the backend implementation.
+     * @return const std::basic_string<T_str> The whole print content in string format.
+     */
+    template <class... Args>
+    const std::basic_string<T_str> operator()( mode&& first, Args&&... args ) const
+     { 
+      if constexpr( sizeof...( args ) > 0 )
+       {
+        switch( first )
          {
-          os << separator;
-          os << elem;
-          separator = StringConverter<T_str>( ", "s );
+          case mode::str:
+           {
+            static std::basic_ostringstream<T_str> oss;
+            oss.str( StringConverter<T_str>( ""s ) );
+            oss.clear();
+            print_backend<false>( oss, std::forward<Args>( args )... );
+
+            return oss.str();
+           }
          }
        }
-      else
+       
+      return StringConverter<T_str>( "" );
+     }
+
+    #ifdef PTC_HAS_LITERAL_LINES
+
+    // Literal arguments case
+    /**
+     * @brief Method used to print a line made only of string literals. The line is built at compile-time and written with a single operation if the object has the default configuration; otherwise the arguments are printed through the usual runtime path.
+     * 
+     * @tparam First The first literal.
+     * @tparam Args All the other literals.
+     * @param os The stream in which you want to print the output.
+     */
+    template <fixed_string First, fixed_string... Args>
+    void literal( std::basic_ostream<T_str>& os = default_stream() ) const
+     {
+      static_assert( std::is_same_v<T_str, char>, "Literal lines are available only for char Print objects." );
+
+      constexpr bool escape = First.has_escape() || ( Args.has_escape() || ... );
+      const auto config = this -> config();
+      if ( config -> buffered || async_ || config -> sep != " " || config -> end != "\n" || ! config -> pattern.empty() || config -> timestamp_id != 0 || config -> thread_prefix || ( escape && ! terminal( os, config -> tty_mode ) ) )
        {
-        print_adaptor( os, container_mod( container ) );
+        ( *this )( os, First.data, Args.data... );
+        return;
        }
-      os << ']';
-  
-      return os;
+
+      static constexpr auto line = literal_line<First, Args...>();
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      os.write( line.data, static_cast<std::streamsize>( line.size ) );
+      flush_line( os, line.size );
      }
-  
-    // Overload for std::array printing
+
+    #endif
+
+    // No arguments case
     /**
-     * @brief Overload for std::array printing.
+     * @brief Template operator redefinition used to print an empty line on the screen. This is the no argument case overload. Can be used with "ptc::print()" or "ptc::print( ostream_name )".
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T The type of the array.
-     * @tparam T_no The number of elements of the array.
-     * @param os The stream to which the output is printed.
-     * @param container The array to be printed.
-     * @return std::basic_ostream<T_str>& The stream to which the array is printed to.
+     * @param os The stream in which you want to print the output.
      */
-    template <class T_str, class T, size_t T_no>
-    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const std::array<T, T_no>& container ) 
+    inline void operator () ( std::basic_ostream<T_str>& os = default_stream() ) const
      {
-      std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
-  
-      os << '[';
-      std::copy
-       (
-        std::begin( container ),
-        std::prev( container.end() ),
-        std::ostream_iterator <T> { os, ", " }
-       );
-      os << container.back();
-      os << ']';
-  
-      return os;
+      if ( async_target( os ) )
+       {
+        const auto config = this -> config();
+        enqueue( os, config -> end.data(), config -> end.size(), 0 );
+        return;
+       }
+
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      if ( repeated( os, end.data(), end.size(), 0 ) ) return;
+      os << end;
+      [[maybe_unused]] const bool flushed = flush_line( os, end.size() * sizeof( T_str ) );
+
+      #ifdef PTC_ENABLE_STATS
+      StatsCounters& counters = local_stats();
+      StatsCounters::add( counters.calls, 1 );
+      StatsCounters::add( counters.bytes, end.size() * sizeof( T_str ) );
+      if ( flushed ) StatsCounters::add( counters.flushes, 1 );
+      #endif
      }
-  
-    // Overload for C arrays
+     
+   private:
+
+    //====================================================
+    //     Private structs
+    //====================================================
+
+    // Config
     /**
-     * @brief Overload for C arrays printing.
+     * @brief Struct used to store the settings read while a line is prepared, before the mutex is taken. Snapshots are immutable: each setter discards the current one and the next printing rebuilds it.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T1 The type of the array.
-     * @tparam arrSize The size of the array.
-     * @tparam std::enable_if_t< ! std::is_same <T1,char>::value> Enable if it is not const char*.
-     * @param os The stream to which the array is printed to.
-     * @return std::basic_ostream<T_str>& The stream to which the array is printed to.
      */
-    template <class T_str, class T1, size_t arrSize, 
-    typename = std::enable_if_t< ! std::is_same <T1,char>::value>>
-    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const T1( & arr )[ arrSize ] )
+    struct Config
      {
-      os << '[';
-      if ( arrSize )
+      std::basic_string<T_str> end, sep, pattern;
+      tty tty_mode;
+      bool buffered, dedup, thread_prefix;
+      std::string timestamp_head, timestamp_tail;
+      std::size_t timestamp_digits, timestamp_id;
+      time_zone timestamp_zone;
+      std::vector<std::shared_ptr<const Hook>> pre_hooks, post_hooks;
+     };
+
+    //====================================================
+    //     Private methods
+    //====================================================
+
+    // config
+    /**
+     * @brief Method used to get the snapshot of the settings used to print a line. The snapshot is cached by each thread and rebuilt, under the mutex, only after a setter changed the settings, so the usual cost is an atomic load. The cache holds a weak reference, so that the snapshot (and the hooks in it) is released together with the object. The caller shares its ownership, so that it stays valid even if a nested printing refreshes the cache. The Print mutex must not be held.
+     * 
+     * @return std::shared_ptr<const Config> The configuration snapshot.
+     */
+    std::shared_ptr<const Config> config() const
+     {
+      thread_local std::uint64_t last_id = 0;
+      thread_local std::weak_ptr<const Config> last;
+
+      // Objects get their id lazily, so that a cached snapshot is never reused by a new object at the same address
+      std::uint64_t id = config_id_.load( std::memory_order_acquire );
+      if ( id == 0 )
        {
-        std::basic_string<T_str> separator = StringConverter<T_str>( ""s );
-        for ( const auto& elem: arr )
+        const std::uint64_t new_id = config_id();
+        if ( config_id_.compare_exchange_strong( id, new_id, std::memory_order_acq_rel ) ) id = new_id;
+       }
+      if ( id == last_id )
+       {
+        if ( auto cached = last.lock() ) return cached; // Expired only while a setter is discarding it
+       }
+
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      if ( ! config_ )
+       {
+        config_ = std::make_shared<const Config>( Config{ end, sep, pattern, tty_mode, buffered(), dedup_window.count() > 0, thread_prefix_,
+                                                          timestamp_head, timestamp_tail, timestamp_digits, timestamp_id_, timestamp_zone,
+                                                          pre_hooks, post_hooks } );
+       }
+      last = config_;
+      last_id = config_id_.load( std::memory_order_relaxed );
+
+      return config_;
+     }
+
+    // changed
+    /**
+     * @brief Method used by the setters to discard the configuration snapshot. The Print mutex must be held.
+     * 
+     */
+    void changed()
+     {
+      config_.reset();
+      config_id_.store( config_id(), std::memory_order_release );
+     }
+
+    // is_escape
+    /**
+     * @brief This method is used to check if an input variable is an ANSI escape sequency or not.
+     * 
+     * @tparam T Template type of the input variable.
+     * @param str The input variable.
+     * @param flag A flag which let to return different things with respect to its value. If flag = ANSI::first the ANSI is searched as the first substring of the str argument, otherwise, if flag = ANSI::generic the ANSI is searched as a substring inside the str argument.
+     * @return true If the input variable is an ANSI escape sequency.
+     * @return false Otherwise.
+     */
+    template <typename T>
+    static constexpr bool is_escape( const T& str, const ANSI& flag )
+     {
+      if constexpr( std::is_convertible_v <T, std::basic_string_view<T_str>> && ! std::is_same_v<T, std::nullptr_t> )
+       {
+        switch( flag )
          {
-          os << separator;
-          os << elem;
-          separator = StringConverter<T_str>( ", "s );
+          case( ANSI::first ): 
+           {
+            return ( std::basic_string_view<T_str>( str ).length() < 7 ) && ( str[0] == '\033' );
+           }
+          case( ANSI::generic ):
+           {
+            return ( std::basic_string_view<T_str>( str ).find( '\033' ) != std::basic_string_view<T_str>::npos );
+           }
          }
        }
-      os << ']';
-  
-      return os;
+      return false;
      }
-  
-    // Overload for std::chrono::duration objects
+      
+    // write_prefix
     /**
-     * @brief Operator << overload for std::chrono::duration objects printing.
+     * @brief Method used to write the enabled line prefixes, each followed by the "sep" variable. Prefixes are written unformatted, so that a width set on the stream still applies to the first argument.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T_time The order of magnitude of the time object.
-     * @tparam int_type The int type of the time object.
-     * @param os The stream to which the time object is printed to.
-     * @param val The time object.
-     * @return std::basic_ostream<T_str>& The stream to which the time object is printed to.
+     * @tparam T_os The type of the output stream object.
+     * @param os The stream in which you want to print the output.
+     * @param config The configuration snapshot.
      */
-    template <class T_str, class T_time, class int_type>
-    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, const std::chrono::duration<int_type, T_time>& val )
+    template <class T_os>
+    void write_prefix( T_os& os, const Config& config ) const
      {
-      if constexpr( ! std::is_same_v<std::chrono::duration<int_type, T_time>, std::chrono::duration<int_type>> )
+      const std::basic_string<T_str>& sep = config.sep;
+      if ( config.timestamp_id != 0 )
        {
-        static std::unordered_map<std::type_index, std::basic_string_view<T_str>> time_map
+        const auto& timestamp = render_timestamp<T_str>( config.timestamp_id, config.timestamp_head, config.timestamp_tail, config.timestamp_digits, config.timestamp_zone );
+        os.write( timestamp.data(), static_cast<std::streamsize>( timestamp.size() ) );
+        os.write( sep.data(), static_cast<std::streamsize>( sep.size() ) );
+       }
+      if ( config.thread_prefix )
+       {
+        const auto& prefix = thread_prefix<T_str>();
+        os.write( prefix.data(), static_cast<std::streamsize>( prefix.size() ) );
+        os.write( sep.data(), static_cast<std::streamsize>( sep.size() ) );
+       }
+     }
+
+    // erase
+    /**
+     * @brief Method used to erase the type of an argument of a print call. Strings of any char type are normalized to a pointer to their first char (so that literals of different length share the same formatter), functions (e.g. manipulators) are stored as function pointers and all the other objects by address.
+     * 
+     * @tparam T The type of the argument.
+     * @param arg The argument.
+     * @return ErasedArg<T_str> The type-erased argument.
+     */
+    template <class T>
+    static ErasedArg<T_str> erase( T& arg )
+     {
+      ErasedArg<T_str> erased;
+      if constexpr( std::is_function_v<T> )
+       {
+        erased.value.function = reinterpret_cast<void (*)()>( &arg );
+        erased.write = &write_function<T_str, T>;
+       }
+      else if constexpr( is_char_string_v<T_str, T> )
+       {
+        using char_type = std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>;
+        const char_type* str = arg;
+        erased.value.object = const_cast<char_type*>( str );
+        erased.write = &write_string<T_str, char_type>;
+       }
+      else
+       {
+        erased.value.object = const_cast<void*>( static_cast<const void*>( std::addressof( arg ) ) );
+        erased.write = &write_object<T_str, T>;
+        if constexpr( std::is_same_v<std::remove_cv_t<T>, std::basic_string<T_str>> || std::is_same_v<std::remove_cv_t<T>, std::basic_string_view<T_str>> )
          {
-          { typeid( std::nano ), StringConverter<T_str>( "ns" ) },
-          { typeid( std::micro ), StringConverter<T_str>( "us" ) },
-          { typeid( std::milli ), StringConverter<T_str>( "ms" ) },
-          { typeid( std::ratio<60> ), StringConverter<T_str>( "min" ) },
-          { typeid( std::ratio<3600> ), StringConverter<T_str>( "h" ) }
-         };
-  
-        #if ( __cplusplus >= 202002L )
-        time_map.insert( { typeid( std::ratio<86400> ), StringConverter<T_str>( "d" ) } );
-        time_map.insert( { typeid( std::ratio<604800> ), StringConverter<T_str>( "w" ) } );
-        time_map.insert( { typeid( std::ratio<2629746> ), StringConverter<T_str>( "mos" ) } );
-        time_map.insert( { typeid( std::ratio<31556952> ), StringConverter<T_str>( "y" ) } );
-        #endif
-         
-        os << val.count() << time_map[ typeid( T_time ) ];
+          erased.data = arg.data();
+          erased.size = arg.size();
+         }
        }
-      else if constexpr( std::is_same_v<std::chrono::duration<int_type, T_time>, std::chrono::duration<int_type>> )
+      erased.escape = is_escape( arg, ANSI::generic );
+
+      return erased;
+     }
+
+    // write_arg
+    /**
+     * @brief Method used to write a type-erased argument to a stream. Large strings are only recorded as cuts of the line if it is going to be gathered, unless a width is set on the stream.
+     * 
+     * @param os The stream in which you want to print the output.
+     * @param arg The type-erased argument.
+     * @param cut_into If not null, the LineStream (bound to "os") in which large strings are referenced instead of being copied.
+     */
+    void write_arg( std::basic_ostream<T_str>& os, const ErasedArg<T_str>& arg, LineStream<T_str>* cut_into ) const
+     {
+      if ( cut_into && arg.size >= FastStreambuf::gather_threshold && os.width() == 0 )
        {
-        os << val.count() << 's';
+        cut_into -> cuts.push_back( { cut_into -> buffer.size(), { arg.data, arg.size } } );
        }
-  
-      return os;
+      else arg.write( os, arg.value );
      }
-  
-    // Overload for std::optional
+
+    // write_line
     /**
-     * @brief Operator << overload for std::optional printing.
+     * @brief Method used to write the arguments of a print call, followed by the "end" variable, to a stream. The stream is automatically reset in case of an ANSI escape sequence is sent to output. It is shared by all the argument types.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T The type of the std::optional value.
-     * @param os The stream to which the time object is printed to.
-     * @param opt The std::optional value.
-     * @return std::basic_ostream<T_str>& The stream to which the time object is printed to.
+     * @param os The stream in which you want to print the output.
+     * @param line The type-erased arguments.
+     * @param config The configuration snapshot.
+     * @param stream If not null, the LineStream bound to "os", in which the size of the prefixes is stored.
+     * @param gather If true, large strings are referenced in "stream" instead of being copied.
+     * @return true If the ANSI reset sequence has been written.
+     * @return false Otherwise.
      */
-    template <class T_str, class T>
-    std::basic_ostream<T_str>& operator <<( std::basic_ostream<T_str>& os, std::optional<T> const& opt )
+    bool write_line( std::basic_ostream<T_str>& os, const ErasedLine<T_str>& line, const Config& config, LineStream<T_str>* stream = nullptr, bool gather = false ) const
      {
-      if ( opt ) os << opt.value();
-      else os << "nullopt"; 
-      
-      return os;
-     }
-
-    // Overload for std::tuple
-    template<std::size_t...> 
-    struct seq{};
-
-    template<std::size_t N, std::size_t... Is>
-    struct gen_seq: gen_seq<N-1, N-1, Is...>{};
+      LineStream<T_str>* cut_into = gather ? stream : nullptr;
+      const std::basic_string<T_str>& pattern = config.pattern;
+      const std::basic_string<T_str>& sep = config.sep;
 
-    template<std::size_t... Is>
-    struct gen_seq<0, Is...> : seq<Is...>{};
+      // Printing the prefixes
+      if ( line.prefixed ) write_prefix( os, config );
+      if ( stream ) stream -> prefix = stream -> buffer.size();
 
-    template<class T_str, class Tuple, std::size_t... Is>
-    void print_tuple( std::basic_ostream<T_str>& os, const Tuple& tup, seq<Is...> )
-     {
-      using swallow = int[];
-      ( void )swallow{ 0, ( void( os << ( Is == 0 ? "" : ", " ) << std::get<Is>( tup ) ), 0 )... };
+      // Printing the first argument
+      const ErasedArg<T_str>& first = line.args[0];
+      if( line.first_escape || pattern.empty() ) write_arg( os, first, cut_into );
+      else
+       {
+        os << pattern;
+        write_arg( os, first, cut_into );
+        os << pattern;
+       }
+      
+      // Printing all the other arguments
+      bool reset = first.escape;
+      for( std::size_t i = 1; i < line.count; ++i )
+       {
+        const ErasedArg<T_str>& arg = line.args[i];
+        if ( ! line.first_escape ) os << sep;
+        if ( pattern.empty() ) write_arg( os, arg, cut_into );
+        else
+         {
+          os << pattern;
+          write_arg( os, arg, cut_into );
+          os << pattern;
+         }
+        if ( line.first_escape ) os << sep;
+        reset = reset || arg.escape;
+       }
+      os << config.end;
+      
+      // Resetting the stream from ANSI escape sequences
+      if ( reset ) os << "\033[0m";
+      
+      return reset;
      }
-    
-    template<class T_str, class... Args>
-    std::basic_ostream<T_str>& operator<<( std::basic_ostream<T_str>& os, const std::tuple<Args...>& tup )
-     {
-      os << "(";
-      print_tuple( os, tup, gen_seq<sizeof...( Args )>() );
-      os << ")";
 
-      return os;
-     }
-  
-    #endif
-  
-    //====================================================
-    //     Functions used to select printing format
-    //====================================================
-  
-    // ptr
+    // print_backend
     /**
-     * @brief Function used to print memory and address information about a generic pointer.
+     * @brief Backend implementation of the () operator overloads to print to the output stream. The arguments are type-erased here, so that the rest of the backend is compiled once for all the argument packs.
      * 
-     * @tparam T_str The char type of the ostream object.
-     * @tparam T The type of the pointer.
-     * @param ptr The pointer.
-     * @return std::basic_string<T_str> The stream to which the time object is printed to.
+     * @tparam prefixed If true the line prefixes (e.g. the timestamp) are written before the arguments.
+     * @tparam T_os The type of the output stream object.
+     * @tparam T Generic type of first object to be printed.
+     * @tparam Args Generic type of all the other objects to be printed.
+     * @param os The stream in which you want to print the output.
+     * @param first First printed object.
+     * @param args The list of objects to be printed on the screen.
      */
-    template <class T_str = char, class T>
-    std::basic_string<T_str> ptr( T* ptr )
+    template <bool prefixed, class T_os, class T, class... Args>
+    void print_backend( T_os&& os, T&& first, Args&&... args ) const
      {
-      static std::basic_ostringstream<T_str> oss;
-      oss.str( StringConverter<T_str>( ""s ) );
-      oss.clear();
-  
-      oss << "Value: " << ptr << "\n";
-      oss << "Address: " << &ptr;
-  
-      return oss.str();
+      const ErasedArg<T_str> erased[] = { erase( first ), erase( args )... };
+      print_erased( os, ErasedLine<T_str>{ erased, 1 + sizeof...( args ), is_escape( first, ANSI::first ), prefixed } );
      }
-   }
-
-  //====================================================
-  //     ptc_print class
-  //====================================================
-  /**
-   * @brief Class used to construct the print function.
-   * 
-   * @tparam T_str The type of the string objects defined inside the struct. This template is used in case you are dealing with std::string or std::wstring objects.
-   */
-  template <class T_str>
-  struct Print
-   {
-    //====================================================
-    //     Public constructors and destructor
-    //====================================================
 
-    // Default constructor
+    // gather_target
     /**
-     * @brief Default constructor of the Print class. It initializes the basic class members and enable (if required) performance improvements..
+     * @brief Method used to check if a line has to be gathered: it must contain a large string argument and it must be written to a FastStreambuf.
      * 
+     * @param os The stream in which you want to print the output.
+     * @param line The type-erased arguments.
+     * @return FastStreambuf* The buffer of the stream if the line has to be gathered, nullptr otherwise.
      */
-    explicit Print(): 
-     end( StringConverter<T_str>( "\n"s ) ),
-     sep( StringConverter<T_str>( " "s ) ),
-     flush( false )
-     {       
-      #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
-      performance_options();
-      #endif
+    static FastStreambuf* gather_target( std::basic_ostream<T_str>& os, const ErasedLine<T_str>& line )
+     {
+      if constexpr( std::is_same_v<T_str, char> )
+       {
+        for( std::size_t i = 0; i < line.count; ++i )
+         {
+          if ( line.args[i].size >= FastStreambuf::gather_threshold ) return dynamic_cast<FastStreambuf*>( os.rdbuf() );
+         }
+       }
+      return nullptr;
      }
 
-    //====================================================
-    //     Public structs
-    //====================================================
-
-    // select_cout
+    // print_erased
     /**
-     * @brief Struct used to define a way to template the choice of the "std::cout" object in order to be "std::cout" for "char" type or "std::wcout" for "wchar_t" type.
+     * @brief Method used to print a line of type-erased arguments. The line is written directly to the stream, or formatted in memory first if it has to be measured. All the decisions taken before the mutex is locked use the configuration snapshot.
      * 
-     * @tparam T The template type of the "std::cout" object (char, wchar_t, ...).
-     */  
-    template <class T> 
-    struct select_cout
+     * @param os The stream in which you want to print the output.
+     * @param line The type-erased arguments.
+     */
+    void print_erased( std::basic_ostream<T_str>& os, const ErasedLine<T_str>& line ) const
      {
-      static std::basic_ostream<T> &cout;
-     };
+      const auto config = this -> config();
+      const bool async = async_target( os );
+      const bool strip = line.prefixed && has_escape( line, *config ) && ! terminal( os, config -> tty_mode );
+      FastStreambuf* gather = async || strip || config -> dedup ? nullptr : gather_target( os, line );
+      if ( config -> buffered || async || gather || strip )
+       {
+        print_buffered( os, line, *config, gather, strip );
+       }
+      else
+       {
+        std::lock_guard <std::mutex> lock{ mutex_ };
+        write_line( os, line, *config );
+        flush_line( os, 0 );
+       }
+     }
 
-    #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
-   
-    // select_cin
+    // has_escape
     /**
-     * @brief Struct used to define a way to template the choice of the "std::cin" object in order to be "std::cin" for "char" type or "std::wcin" for "wchar_t" type.
+     * @brief Method used to check if a line contains an ANSI escape sequence, in its arguments or in the "pattern", "sep" and "end" variables.
      * 
-     * @tparam T The template type of the "std::cin" object (char, wchar_t, ...).
-     */  
-    template <class T> 
-    struct select_cin
+     * @param line The type-erased arguments.
+     * @param config The configuration snapshot.
+     * @return true If the line contains an ANSI escape sequence.
+     * @return false Otherwise.
+     */
+    static bool has_escape( const ErasedLine<T_str>& line, const Config& config )
      {
-      static std::basic_istream<T> &cin;
-     };
-  
-    #endif
-
-    //====================================================
-    //     Public setters
-    //====================================================
+      if ( config.tty_mode == tty::always ) return false;
+      for( std::size_t i = 0; i < line.count; ++i )
+       {
+        if ( line.args[ i ].escape ) return true;
+       }
+      const T_str escape = T_str( '\033' );
+      return config.pattern.find( escape ) != config.pattern.npos || config.sep.find( escape ) != config.sep.npos || config.end.find( escape ) != config.end.npos;
+     }
 
-    // setEnd
+    // terminal
     /**
-     * @brief Setter used to set the value of the "end" variable. Templated type is required in order to allow also char variables.
+     * @brief Method used to check if a stream is treated as a terminal, according to a tty mode.
      * 
-     * @tparam T The type of the expression inserted to set the value of "end" variable.
-     * @param end_val The inserted expression used to set the value of "end" variable.
+     * @param os The stream.
+     * @param mode The tty mode (see setTTY).
+     * @return true If the stream is treated as a terminal.
+     * @return false Otherwise.
      */
-    template <class T> 
-    inline void setEnd( const T& end_val )
+    static bool terminal( const std::basic_ostream<T_str>& os, tty mode )
      {
-      end = end_val;
+      if ( mode != tty::automatic ) return mode == tty::always;
+      return is_terminal_sink( os );
      }
 
-    // setSep
+    // buffered
     /**
-     * @brief Setter used to set the value of the "sep" variable. Templated type is required in order to allow also char variables.
+     * @brief Method used to check if lines have to be formatted in memory before being written. The Print mutex must be held.
      * 
-     * @tparam T The type of the expression inserted to set the value of "sep" variable.
-     * @param end_val The inserted expression used to set the value of "sep" variable.
+     * @return true If lines have to be formatted in memory.
+     * @return false Otherwise.
      */
-    template <class T>
-    inline void setSep( const T& sep_val )
+    inline bool buffered() const
      {
-      sep = sep_val;
+      #ifdef PTC_ENABLE_STATS
+      return true;
+      #else
+      return ! pre_hooks.empty() || ! post_hooks.empty() || flush_policy.bytes > 0 || dedup_window.count() > 0;
+      #endif
      }
 
-    // setFlush
+    // flush_line
     /**
-     * @brief Setter used to set the value of the "flush" variable. Templated type is required in order to allow also char variables.
+     * @brief Method used to flush the stream after a line has been written, if required by the "flush" variable or by the flush policy, whether the stream is a terminal or not. The Print mutex must be held.
      * 
-     * @param flush_val The inserted expression used to set the value of the "flush" variable.
+     * @tparam T_os The type of the output stream object.
+     * @param os The stream the line has been written to.
+     * @param bytes The size of the line in bytes (used only by the bytes policy).
+     * @return true If the stream has been flushed.
+     * @return false Otherwise.
      */
-    inline void setFlush( const bool& flush_val )
+    template <class T_os>
+    bool flush_line( T_os& os, std::size_t bytes ) const
      {
-      flush = flush_val;
+      ++lines_since_flush;
+      bytes_since_flush += bytes;
+      bool flush_now = flush ||
+                       ( flush_policy.lines > 0 && lines_since_flush >= flush_policy.lines ) ||
+                       ( flush_policy.bytes > 0 && bytes_since_flush >= flush_policy.bytes ) ||
+                       ( flush_policy.on_error && is_error_stream( &os ) );
+      if ( ! flush_now && flush_policy.interval.count() > 0 )
+       {
+        const auto now = std::chrono::steady_clock::now();
+        if ( last_flush == std::chrono::steady_clock::time_point{} ) last_flush = now;
+        flush_now = now - last_flush >= flush_policy.interval;
+       }
+      if ( ! flush_now ) return false;
+
+      os << std::flush;
+      lines_since_flush = 0;
+      bytes_since_flush = 0;
+      if ( flush_policy.interval.count() > 0 ) last_flush = std::chrono::steady_clock::now();
+
+      return true;
      }
-    
-    // setPattern
+
+    // is_error_stream
     /**
-     * @brief Setter used to set the value of the "pattern" variable. Templated type is required in order to allow also char variables.
+     * @brief Method used to check if a stream is one of the standard error streams.
      * 
-     * @tparam T The type of the expression inserted to set the value of "pattern" variable.
-     * @param pattern_val The inserted expression used to set the value of "pattern" variable.
+     * @param os The stream.
+     * @return true If the stream is std::cerr, std::clog or one of their wide versions.
+     * @return false Otherwise.
      */
-    template <class T>
-    inline void setPattern( const T& pattern_val )
+    static bool is_error_stream( const void* os )
      {
-      pattern = pattern_val;
+      return os == &std::cerr || os == &std::clog || os == &std::wcerr || os == &std::wclog;
      }
 
-    //====================================================
-    //     Public getters
-    //====================================================
-
-    #ifdef PTC_ENABLE_GETTERS_FOR_UNIT_TESTS
-
-    // getEnd
+    // print_buffered
     /**
-     * @brief Getter used to get the value of the "end" variable. Mainly used for debugging.
+     * @brief Method used to format a line into the thread-local LineStream and then write it to the output stream in a single operation. Formatting happens before the mutex is taken. Timings are measured only if statistics or hooks require them.
      * 
-     * @return auto The value of the "end" variable.
+     * @param os The stream in which you want to print the output.
+     * @param erased The type-erased arguments.
+     * @param config The configuration snapshot.
+     * @param gather If not null, the FastStreambuf of "os": the line is written with a single gathered write, in which large strings are not copied.
+     * @param strip If true the ANSI escape sequences are removed from the line.
      */
-    inline const auto& getEnd() const 
+    void print_buffered( std::basic_ostream<T_str>& os, const ErasedLine<T_str>& erased, const Config& config, FastStreambuf* gather = nullptr, bool strip = false ) const
      {
-      return end;
+      using clock = std::chrono::steady_clock;
+
+      #ifdef PTC_ENABLE_STATS
+      const bool measured = true;
+      #else
+      const bool measured = ! config.pre_hooks.empty() || ! config.post_hooks.empty();
+      #endif
+
+      PrintEvent<T_str> event;
+      event.stream = &os;
+      if ( measured ) event.start = clock::now();
+
+      // Formatting the line with the stream settings
+      LineStream<T_str>& line = line_stream<T_str>();
+      line.buffer.clear();
+      line.cuts.clear();
+      line.os.flags( os.flags() );
+      line.os.precision( os.precision() );
+      line.os.width( os.width() );
+      if constexpr( std::is_same_v<T_str, char> || std::is_same_v<T_str, wchar_t> ) line.os.fill( os.fill() ); // Other char types have no ctype facet to widen the default fill
+      if ( line.os.getloc() != os.getloc() ) line.os.imbue( os.getloc() );
+      [[maybe_unused]] const bool reset = write_line( line.os, erased, config, &line, gather != nullptr ) && ! strip;
+      os.flags( line.os.flags() );
+      os.precision( line.os.precision() );
+      os.width( line.os.width() );
+      if constexpr( std::is_same_v<T_str, char> || std::is_same_v<T_str, wchar_t> ) os.fill( line.os.fill() );
+      if ( ! line.os ) 
+       {
+        os.setstate( line.os.rdstate() );
+        line.os.clear();
+       }
+      if ( strip )
+       {
+        const std::size_t prefix = strip_escapes( line.buffer.data(), line.prefix );
+        const std::size_t rest = strip_escapes( line.buffer.data() + line.prefix, line.buffer.size() - line.prefix );
+        std::char_traits<T_str>::move( line.buffer.data() + prefix, line.buffer.data() + line.prefix, rest );
+        line.buffer.resize( prefix + rest );
+        line.prefix = prefix;
+       }
+
+      event.bytes = line.buffer.size() * sizeof( T_str );
+      for( const auto& cut: line.cuts ) event.bytes += cut.text.size() * sizeof( T_str );
+      clock::time_point formatted;
+      if ( measured )
+       {
+        formatted = clock::now();
+        event.formatting = formatted - event.start;
+       }
+      for( const auto& hook: config.pre_hooks ) ( *hook )( event );
+
+      // Writing or queueing the line
+      [[maybe_unused]] bool flushed = false, suppressed = false;
+      if ( async_target( os ) )
+       {
+        enqueue( os, line.buffer.data(), line.buffer.size(), line.prefix );
+        if ( measured ) event.writing = clock::now() - formatted;
+       }
+      else
+       {
+        std::lock_guard <std::mutex> lock{ mutex_ };
+        const auto locked = measured ? clock::now() : clock::time_point{};
+
+        if ( gather ) write_gathered( os, *gather, line );
+        else if ( erased.prefixed && repeated( os, line.buffer.data(), line.buffer.size(), line.prefix ) ) suppressed = true;
+        else os.write( line.buffer.data(), static_cast<std::streamsize>( line.buffer.size() ) );
+        flushed = ! suppressed && flush_line( os, event.bytes );
+
+        if ( measured )
+         {
+          event.lock_wait = locked - formatted;
+          event.writing = clock::now() - locked;
+         }
+       }
+      for( const auto& hook: config.post_hooks ) ( *hook )( event );
+
+      #ifdef PTC_ENABLE_STATS
+      StatsCounters& counters = local_stats();
+      StatsCounters::add( counters.calls, 1 );
+      StatsCounters::add( counters.bytes, event.bytes );
+      if ( flushed ) StatsCounters::add( counters.flushes, 1 );
+      if ( reset ) StatsCounters::add( counters.ansi_resets, 1 );
+      StatsCounters::add( counters.formatting, static_cast<std::uint64_t>( event.formatting.count() ) );
+      StatsCounters::add( counters.lock_wait, static_cast<std::uint64_t>( event.lock_wait.count() ) );
+      StatsCounters::add( counters.writing, static_cast<std::uint64_t>( event.writing.count() ) );
+      #endif
      }
 
-    // getSep
+    // write_gathered
     /**
-     * @brief Getter used to get the value of the "sep" variable. Mainly used for debugging.
+     * @brief Method used to write a formatted line and the large strings it references with a single gathered write. The Print mutex must be held.
      * 
-     * @return auto The value of the "sep" variable.
+     * @param os The stream in which you want to print the output.
+     * @param gather The FastStreambuf of the stream.
+     * @param line The formatted line.
      */
-    inline const auto& getSep() const
+    static void write_gathered( std::basic_ostream<T_str>& os, FastStreambuf& gather, LineStream<T_str>& line )
      {
-      return sep;
+      if constexpr( std::is_same_v<T_str, char> )
+       {
+        const std::string_view text( line.buffer.data(), line.buffer.size() );
+        std::size_t pos = 0;
+        line.pieces.clear();
+        for( const auto& cut: line.cuts )
+         {
+          if ( cut.pos > pos ) line.pieces.push_back( text.substr( pos, cut.pos - pos ) );
+          line.pieces.push_back( cut.text );
+          pos = cut.pos;
+         }
+        if ( pos < text.size() ) line.pieces.push_back( text.substr( pos ) );
+        if ( ! gather.writeGathered( line.pieces.data(), line.pieces.size() ) ) os.setstate( std::ios_base::badbit );
+       }
      }
 
-    // getFlush
+    // write_table
     /**
-     * @brief Getter used to get the value of the "flush" variable. Mainly used for debugging.
+     * @brief Method used to write a table built in a TableArena with a single operation. The stream is reset if a cell contains an ANSI escape sequence.
      * 
-     * @return bool The value of the "flush" variable.
+     * @param os The stream in which you want to print the table.
+     * @param arena The arena which contains the table.
+     * @param config The configuration snapshot.
      */
-    inline const bool& getFlush() const
+    void write_table( std::basic_ostream<T_str>& os, TableArena<T_str>& arena, const Config& config ) const
      {
-      return flush;
+      if ( arena.escape )
+       {
+        if ( terminal( os, config.tty_mode ) ) arena.text.append( { T_str( '\033' ), T_str( '[' ), T_str( '0' ), T_str( 'm' ) } );
+        else arena.text.resize( strip_escapes( arena.text.data(), arena.text.size() ) );
+       }
+      if ( arena.text.empty() ) return;
+      if ( async_target( os ) )
+       {
+        enqueue( os, arena.text.data(), arena.text.size(), 0 );
+        return;
+       }
+
+      std::lock_guard <std::mutex> lock{ mutex_ };
+      if ( repeated( os, arena.text.data(), arena.text.size(), 0 ) ) return;
+      os.write( arena.text.data(), static_cast<std::streamsize>( arena.text.size() ) );
+      flush_line( os, arena.text.size() * sizeof( T_str ) );
      }
 
-    // getPattern
+    // async_target
     /**
-     * @brief Getter used to get the value of the "pattern" variable. Mainly used for debugging.
+     * @brief Method used to check if a line has to be queued for asynchronous printing.
      * 
-     * @return auto The value of the "pattern" variable.
+     * @param os The stream in which you want to print the output.
+     * @return true If asynchronous printing is enabled and the stream is a standard one.
+     * @return false Otherwise.
      */
-    inline const auto& getPattern() const
+    bool async_target( const std::basic_ostream<T_str>& os ) const
      {
-      return pattern;
+      return async_ && is_standard_stream( &os );
      }
 
-    #endif
-
-    //====================================================
-    //     Public operator () overloads
-    //====================================================
-
-    // General case
+    // enqueue
     /**
-     * @brief Frontend implementation of the () operator overload to print to the output stream. The backend implementation is called in the required variation.
+     * @brief Method used to queue a formatted line for the background thread, applying the overflow policy if the queue is full.
      * 
-     * @tparam T Generic type of first object to be passed as argument to the backend implementation.
-     * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
-     * @param first First object to be passed to the backend implementation.
-     * @param args The list of all the other objects to be passed to the backend implementation.
+     * @param os The stream in which the line has to be written.
+     * @param data The line.
+     * @param size The size of the line.
+     * @param prefix The size of the line prefixes, which are excluded from the deduplication.
      */
-    template <class T, class... Args>
-    void operator()( T&& first, Args&&... args ) const
+    void enqueue( std::basic_ostream<T_str>& os, const T_str* data, std::size_t size, std::size_t prefix ) const
      {
-      if constexpr ( std::is_base_of_v <std::basic_ostream<T_str>, std::remove_reference_t<T>> )
-       {
-        print_backend( std::forward<T>( first ), std::forward<Args>( args )... );
-       }
-      else
+      AsyncState<T_str>& state = *async_;
+      std::unique_lock <std::mutex> lock{ state.mutex };
+      if ( state.queue.size() >= state.policy.capacity && ! state.stop )
        {
-        print_backend( select_cout<T_str>::cout, std::forward<T>( first ), std::forward<Args>( args )... );
+        switch( state.policy.on_overflow )
+         {
+          case( overflow::block ):
+           {
+            ++state.stats.blocked;
+            state.not_full.wait( lock, [ &state ]{ return state.queue.size() < state.policy.capacity || state.stop; } );
+            break;
+           }
+          case( overflow::drop_newest ):
+           {
+            ++state.stats.dropped;
+            ++state.unreported;
+            return;
+           }
+          case( overflow::overwrite_oldest ):
+           {
+            state.unreported += state.queue.front().lost_before; // Moved to the next queued line
+            state.queue.pop_front();
+            ++state.stats.overwritten;
+            ++state.unreported;
+            break;
+           }
+          case( overflow::spill ):
+           {
+            state.spill.write( reinterpret_cast<const char*>( data ), static_cast<std::streamsize>( size * sizeof( T_str ) ) );
+            ++state.stats.spilled;
+            return;
+           }
+         }
        }
+      state.queue.push_back( { &os, std::basic_string<T_str>( data, size ), prefix, std::exchange( state.unreported, 0 ) } );
+      ++state.stats.queued;
+      lock.unlock();
+      state.not_empty.notify_one();
      }
 
-    // String initialization case
+    // async_loop
     /**
-     * @brief Frontend implementation of the () operator overload to initialize its content with an std::string object. The backend implementation is called in the required variation. This overload is required in order to hide the output of the "print_backend" function during the initialization.
+     * @brief Method run by the background thread of the asynchronous printing: it takes the whole queue at once and writes it while holding the Print mutex. The lines lost before a queued line are reported just before it.
      * 
-     * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
-     * @param first First object to be passed to the backend implementation.
-     * @param args The list of all the other objects to be passed to the backend implementation.
-     * @return const std::basic_string<T_str> The whole print content in string format.
      */
-    template <class... Args>
-    const std::basic_string<T_str> operator()( mode&& first, Args&&... args ) const
-     { 
-      if constexpr( sizeof...( args ) > 0 )
+    void async_loop() const
+     {
+      AsyncState<T_str>& state = *async_;
+      std::deque<typename AsyncState<T_str>::Item> batch;
+      std::unique_lock <std::mutex> lock{ state.mutex };
+      while( true )
        {
-        switch( first )
+        state.not_empty.wait( lock, [ &state ]{ return state.stop || ! state.queue.empty(); } );
+        if ( state.queue.empty() ) break;
+
+        batch.swap( state.queue );
+        state.busy = true;
+        lock.unlock();
+        state.not_full.notify_all();
+
          {
-          case mode::str:
+          std::lock_guard <std::mutex> write_lock{ mutex_ };
+          for( const auto& item: batch )
            {
-            static std::basic_ostringstream<T_str> oss;
-            oss.str( StringConverter<T_str>( ""s ) );
-            oss.clear();
-            print_backend( oss, std::forward<Args>( args )... );
-
-            return oss.str();
+            if ( item.lost_before > 0 && state.policy.summary ) write_summary( *item.os, item.lost_before );
+            if ( repeated( *item.os, item.line.data(), item.line.size(), item.prefix ) ) continue;
+            item.os -> write( item.line.data(), static_cast<std::streamsize>( item.line.size() ) );
+            flush_line( *item.os, item.line.size() * sizeof( T_str ) );
            }
          }
+
+        lock.lock();
+        state.stats.written += batch.size();
+        state.last = batch.back().os;
+        state.busy = false;
+        batch.clear();
+        state.idle.notify_all();
        }
-       
-      return StringConverter<T_str>( "" );
      }
 
-    // No arguments case
+    // write_summary
     /**
-     * @brief Template operator redefinition used to print an empty line on the screen. This is the no argument case overload. Can be used with "ptc::print()" or "ptc::print( ostream_name )".
+     * @brief Method used to write the line which reports the lines lost by the asynchronous printing. The Print mutex must be held.
      * 
-     * @param os The stream in which you want to print the output.
+     * @param os The stream.
+     * @param lost The number of lost lines.
      */
-    inline void operator () ( std::basic_ostream<T_str>& os = select_cout<T_str>::cout ) const
+    void write_summary( std::basic_ostream<T_str>& os, std::uint64_t lost ) const
      {
-      os << end;
-      if ( flush ) os << std::flush;
+      write_notice( os, "ptc: " + std::to_string( lost ) + ( lost == 1 ? " line dropped" : " lines dropped" ) );
      }
-     
-   private:
 
-    //====================================================
-    //     Private methods
-    //====================================================
+    // write_notice
+    /**
+     * @brief Method used to write a line generated by the Print object itself, followed by the "end" variable. The Print mutex must be held.
+     * 
+     * @param os The stream.
+     * @param text The text of the line.
+     */
+    void write_notice( std::basic_ostream<T_str>& os, const std::string& text ) const
+     {
+      for( const char ch: text ) os.put( static_cast<T_str>( ch ) );
+      os.write( end.data(), static_cast<std::streamsize>( end.size() ) );
+     }
 
-    // is_escape
+    // repeated
     /**
-     * @brief This method is used to check if an input variable is an ANSI escape sequency or not.
+     * @brief Method used to check if a formatted line is a duplicate to be suppressed: it must be written to a standard stream (the only ones which surely outlive the pending report), it must have the same hash and size (prefixes excluded) as the last line written to the same stream, and the deduplication window opened by that line must not have expired. Duplicates are counted; otherwise the pending count is reported and the line becomes the reference one. The Print mutex must be held.
      * 
-     * @tparam T Template type of the input variable.
-     * @param str The input variable.
-     * @param flag A flag which let to return different things with respect to its value. If flag = ANSI::first the ANSI is searched as the first substring of the str argument, otherwise, if flag = ANSI::generic the ANSI is searched as a substring inside the str argument.
-     * @return true If the input variable is an ANSI escape sequency.
-     * @return false Otherwise.
+     * @param os The stream in which the line has to be written.
+     * @param data The line.
+     * @param size The size of the line.
+     * @param prefix The size of the line prefixes, which are excluded from the comparison.
+     * @return true If the line has to be suppressed.
+     * @return false If the line has to be written.
      */
-    template <typename T>
-    static constexpr bool is_escape( const T& str, const ANSI& flag )
+    bool repeated( std::basic_ostream<T_str>& os, const T_str* data, std::size_t size, std::size_t prefix ) const
      {
-      if constexpr( std::is_convertible_v <T, std::basic_string_view<T_str>> && ! std::is_same_v<T, std::nullptr_t> )
+      if ( dedup_window.count() == 0 || ! is_standard_stream( &os ) ) return false;
+
+      const std::uint64_t hash = fnv1a( data + prefix, size - prefix );
+      const auto now = std::chrono::steady_clock::now();
+      if ( &os == dedup_stream && hash == dedup_hash && size - prefix == dedup_size && now - dedup_time < dedup_window )
        {
-        switch( flag )
-         {
-          case( ANSI::first ): 
-           {
-            return ( std::basic_string_view<T_str>( str ).length() < 7 ) && ( str[0] == '\033' );
-           }
-          case( ANSI::generic ):
-           {
-            return ( std::basic_string_view<T_str>( str ).find( '\033' ) != std::basic_string_view<T_str>::npos );
-           }
-         }
+        ++dedup_repeats;
+        return true;
        }
+
+      if ( dedup_stream ) write_repeats();
+      dedup_stream = &os;
+      dedup_hash = hash;
+      dedup_size = size - prefix;
+      dedup_time = now;
+
       return false;
      }
-      
-    // print_backend
+
+    // write_repeats
     /**
-     * @brief Backend implementation of the () operator overloads to print to the output stream. The stream is automatically reset in case of an ANSI escape sequence is sent to output.
+     * @brief Method used to report the number of suppressed duplicates of the last written line, if any. The Print mutex must be held.
      * 
-     * @tparam T_os The type of the output stream object.
-     * @tparam T Generic type of first object to be printed.
-     * @tparam Args Generic type of all the other objects to be printed.
-     * @param os The stream in which you want to print the output.
-     * @param first First printed object.
-     * @param args The list of objects to be printed on the screen.
      */
-    template <class T_os, class T, class... Args>
-    void print_backend( T_os&& os, T&& first, Args&&... args ) const
+    void write_repeats() const
      {
-      std::lock_guard <std::mutex> lock{ mutex_ };
+      if ( dedup_repeats == 0 ) return;
+      write_notice( *dedup_stream, "last message repeated " + std::to_string( dedup_repeats ) + ( dedup_repeats == 1 ? " time" : " times" ) );
+      dedup_repeats = 0;
+     }
 
-      // Printing the first argument
-      if( is_escape( first, ANSI::first ) || pattern.empty() ) os << first;
-      else os << pattern << first << pattern;
-      
-      // Printing all the other arguments
-      if constexpr( sizeof...( args ) > 0 ) 
+    // stop_async
+    /**
+     * @brief Method used to stop the background thread of the asynchronous printing, after all the queued lines have been written.
+     * 
+     */
+    void stop_async()
+     {
+      if ( ! async_ ) return;
        {
-        if ( is_escape( first, ANSI::first ) ) 
-         {
-          if( pattern.empty() ) ( ( os << args << sep ), ...);
-          else ( ( os << pattern << args << pattern << sep ), ...);
-         }
-        else 
-         {
-          if( pattern.empty() ) ( ( os << sep << args ), ...);
-          else ( ( os << sep << pattern << args << pattern ), ...);
-         }
+        std::lock_guard <std::mutex> lock{ async_ -> mutex };
+        async_ -> stop = true;
        }
-      os << end;
-      
-      // Resetting the stream from ANSI escape sequences
-      if constexpr( sizeof...( args ) > 0 )
+      async_ -> not_empty.notify_all();
+      async_ -> not_full.notify_all();
+      async_ -> worker.join();
+
+      // Reporting the lines lost after the last write
        {
-        if ( is_escape( first, ANSI::generic ) || ( ( is_escape( args, ANSI::generic ) ) || ...) )
-         {
-          os << "\033[0m";
-         }
+        std::lock_guard <std::mutex> lock{ mutex_ };
+        std::basic_ostream<T_str>* os = async_ -> last;
+        if ( os && async_ -> unreported > 0 && async_ -> policy.summary ) write_summary( *os, async_ -> unreported );
+        if ( os ) os -> flush();
        }
-      else 
+      async_.reset();
+     }
+
+    #ifdef PTC_ENABLE_STATS
+
+    // local_stats
+    /**
+     * @brief Method used to get the statistics counters of the calling thread for this object. Counters are created and registered once per thread, then they are reached through a thread-local cache without any locking.
+     * 
+     * @return StatsCounters& The counters of the calling thread.
+     */
+    StatsCounters& local_stats() const
+     {
+      static std::atomic<std::size_t> ids{ 0 };
+      thread_local std::unordered_map<std::size_t, std::shared_ptr<StatsCounters>> local_counters;
+      thread_local std::size_t last_id = 0;
+      thread_local StatsCounters* last_counters = nullptr;
+
+      // Objects get their id lazily, so that ids are never reused by a new object at the same address
+      std::size_t id = stats_id_.load( std::memory_order_acquire );
+      if ( id == 0 )
        {
-       if ( is_escape( first, ANSI::generic ) ) 
-        {
-         os << "\033[0m";
-        }
+        const std::size_t new_id = ids.fetch_add( 1, std::memory_order_relaxed ) + 1;
+        if ( stats_id_.compare_exchange_strong( id, new_id, std::memory_order_acq_rel ) ) id = new_id;
+       }
+      if ( id == last_id ) return *last_counters;
+
+      std::shared_ptr<StatsCounters>& counters = local_counters[ id ];
+      if ( ! counters )
+       {
+        counters = std::make_shared<StatsCounters>();
+        std::lock_guard <std::mutex> lock{ stats_mutex_ };
+        stats_counters_.push_back( counters );
        }
+      last_id = id;
+      last_counters = counters.get();
 
-      // Other operations
-      if ( flush ) os << std::flush;
+      return *counters;
      }
 
-    // performance_options
+    #endif
+
+    // default_stream
     /**
-     * @brief Function used to set on the performance improvements to the operator () overload.
-     *
+     * @brief Method used to get the stream used when none is given: std::cout for char, std::wcout for wchar_t and ptc::utf8_stdout() for the other char types, which is created at its first usage.
+     * 
+     * @return std::basic_ostream<T_str>& The default stream.
      */
-    inline void performance_options() const
+    static std::basic_ostream<T_str>& default_stream()
      {
-      std::lock_guard <std::mutex> lock{ mutex_ };
-      
-      std::ios_base::sync_with_stdio( false );
-      select_cout<T_str>::cout.tie( nullptr );
-
-      #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
-      select_cin<T_str>::cin.tie( nullptr );
-      #endif
+      if constexpr( std::is_same_v<T_str, char> || std::is_same_v<T_str, wchar_t> ) return select_cout<T_str>::cout;
+      else return utf8_stdout<T_str>();
      }
-     
+
     //====================================================
     //     Private attributes
     //====================================================
     std::basic_string<T_str> end, sep, pattern;
-    static std::mutex mutex_;
+    mutable std::shared_ptr<const Config> config_;
+    mutable std::atomic<std::uint64_t> config_id_{ 0 };
+    static std::mutex& mutex_; // Shared by all the char types, since their default streams write to the same standard output
     bool flush;
+    FlushPolicy flush_policy;
+    bool thread_prefix_ = false;
+    std::string timestamp_head, timestamp_tail;
+    std::size_t timestamp_digits = 0, timestamp_id_ = 0;
+    time_zone timestamp_zone = time_zone::local;
+    mutable std::size_t lines_since_flush = 0, bytes_since_flush = 0;
+    mutable std::chrono::steady_clock::time_point last_flush;
+    std::vector<std::shared_ptr<const Hook>> pre_hooks, post_hooks; // Shared with the snapshots, so that stateful hooks are never copied
+    std::unique_ptr<AsyncState<T_str>> async_;
+    tty tty_mode = tty::automatic;
+    std::chrono::milliseconds dedup_window{ 0 };
+    mutable std::basic_ostream<T_str>* dedup_stream = nullptr;
+    mutable std::uint64_t dedup_hash = 0, dedup_repeats = 0;
+    mutable std::size_t dedup_size = 0;
+    mutable std::chrono::steady_clock::time_point dedup_time;
+
+    #ifdef PTC_ENABLE_STATS
+    mutable std::mutex stats_mutex_;
+    mutable std::vector<std::shared_ptr<StatsCounters>> stats_counters_;
+    mutable std::atomic<std::size_t> stats_id_{ 0 };
+    #endif
    };
-   
+
   //====================================================
-  //     Other steps
+  //     ChromeTrace class
   //====================================================
+  /**
+   * @brief Class used as a post-write hook of a Print object to record each printed line as Chrome trace events ("chrome://tracing" / Perfetto JSON array format). Copies share the same file, which is completed when the last copy is destroyed. Timestamps come from std::chrono::steady_clock, in microseconds.
+   * 
+   */
+  class ChromeTrace
+   {
+    public:
+
+     //====================================================
+     //     Public constructors
+     //====================================================
+
+     // Constructor
+     /**
+      * @brief Construct a new ChromeTrace object, which writes its events to a file.
+      * 
+      * @param path The path of the trace file.
+      * @param name The name of the events.
+      * @throw std::runtime_error If the trace file cannot be opened.
+      */
+     explicit ChromeTrace( const std::string& path, const std::string& name = "ptc::print" ):
+      state( std::make_shared<State>( path, name ) )
+      {}
+
+     //====================================================
+     //     Public operator () overloads
+     //====================================================
+
+     // Hook
+     /**
+      * @brief Operator used to record a printed line as a complete event, with nested events for formatting, lock waiting and writing.
+      * 
+      * @tparam T_str The char type of the target stream.
+      * @param event The printed line description.
+      */
+     template <class T_str>
+     void operator()( const PrintEvent<T_str>& event ) const
+      {
+       const double start = std::chrono::duration<double, std::micro>( event.start.time_since_epoch() ).count();
+       const double formatting = std::chrono::duration<double, std::micro>( event.formatting ).count();
+       const double lock_wait = std::chrono::duration<double, std::micro>( event.lock_wait ).count();
+       const double writing = std::chrono::duration<double, std::micro>( event.writing ).count();
+       const std::size_t tid = std::hash<std::thread::id>{}( std::this_thread::get_id() ) & 0x7fffffff; // Kept exactly representable by JSON readers
+
+       std::lock_guard <std::mutex> lock{ state -> mutex };
+       write_event( state -> name, start, formatting + lock_wait + writing, tid, event.bytes, stream_name( event.stream ) );
+       write_event( "format", start, formatting, tid, event.bytes, nullptr );
+       write_event( "lock wait", start + formatting, lock_wait, tid, event.bytes, nullptr );
+       write_event( "write", start + formatting + lock_wait, writing, tid, event.bytes, nullptr );
+      }
+
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+
+     // State
+     /**
+      * @brief Struct used to store the trace file shared among copies of the hook.
+      * 
+      */
+     struct State
+      {
+       State( const std::string& path, const std::string& event_name ):
+        file( path, std::ios::trunc ),
+        name( event_name )
+        {
+         if ( ! file ) throw std::runtime_error( "ptc::ChromeTrace: cannot open the trace file \"" + path + "\"." );
+         #if defined( _WIN32 )
+         pid = _getpid();
+         #else
+         pid = getpid();
+         #endif
+         file.setf( std::ios::fixed );
+         file.precision( 3 );
+         file << "[";
+        }
+
+       ~State()
+        {
+         file << "\n]\n";
+        }
+
+       std::mutex mutex;
+       std::ofstream file;
+       std::string name;
+       long pid;
+       bool first = true;
+      };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // write_event
+     /**
+      * @brief Method used to write a single complete ("X") event to the trace file. The state mutex must be held.
+      * 
+      */
+     void write_event( const std::string& name, double ts, double dur, std::size_t tid, std::size_t bytes, const char* stream ) const
+      {
+       std::ofstream& file = state -> file;
+       file << ( state -> first ? "\n" : ",\n" );
+       state -> first = false;
+       file << R"({"name":")";
+       for( const char c: name )
+        {
+         if ( c == '"' || c == '\\' ) file << '\\';
+         file << c;
+        }
+       file << R"(","cat":"ptc","ph":"X","ts":)" << ts << R"(,"dur":)" << dur;
+       file << R"(,"pid":)" << state -> pid << R"(,"tid":)" << tid << R"(,"args":{"bytes":)" << bytes;
+       if ( stream ) file << R"(,"stream":")" << stream << '"';
+       file << "}}";
+      }
+
+     // stream_name
+     /**
+      * @brief Method used to get a readable name of a target stream.
+      * 
+      * @param stream The target stream.
+      * @return const char* The stream name.
+      */
+     static const char* stream_name( const void* stream )
+      {
+       if ( stream == &std::cout || stream == &std::wcout ) return "stdout";
+       if ( stream == &std::cerr || stream == &std::wcerr ) return "stderr";
+       if ( stream == &std::clog || stream == &std::wclog ) return "stdlog";
+       return "stream";
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     std::shared_ptr<State> state;
+   };
+ }
+
+//====================================================
+//     Other steps
+//====================================================
 
+// Specializations are kept out of the exported block, since a module cannot export them
+namespace ptc
+ {
   // Print structs specializations
   template <> template <> inline std::ostream &Print<char>::select_cout <char>::cout = std::cout;
   template <> template <> inline std::wostream &Print<wchar_t>::select_cout <wchar_t>::cout = std::wcout;
 
+
   #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
   template <> template <> inline std::istream &Print<char>::select_cin <char>::cin = std::cin;
   template <> template <> inline std::wistream &Print<wchar_t>::select_cin <wchar_t>::cin = std::wcin;
   #endif
 
   // Print::mutex_ definiton
-  template <class T_str> inline std::mutex Print <T_str>::mutex_;
+  inline namespace detail { inline std::mutex print_mutex; }
+  template <class T_str> inline std::mutex& Print <T_str>::mutex_ = print_mutex;
+ }
 
+PTC_EXPORT namespace ptc
+ {
   // Print objects initialization
-  inline Print <char> print;        // char
-  inline Print <wchar_t> wprint;    // wchar_t
+  inline PTC_CONSTINIT Print <char> print;        // char
+  inline PTC_CONSTINIT Print <wchar_t> wprint;    // wchar_t
 
-  #if ! defined( PTC_ENABLE_PERFORMANCE_IMPROVEMENTS ) && ! defined( __APPLE__ )
+  #ifndef __APPLE__
   #if ( __cplusplus >= 202002L )
-  inline Print <char8_t> print8;  // char8_t
+  inline PTC_CONSTINIT Print <char8_t> print8;  // char8_t
+  #endif
+  inline PTC_CONSTINIT Print <char16_t> print16;  // char16_t
+  inline PTC_CONSTINIT Print <char32_t> print32;  // char32_t
+  #endif
+
+  #if defined( PTC_ENABLE_PERFORMANCE_IMPROVEMENTS ) || defined( PTC_ENABLE_FAST_STREAMS )
+
+  inline namespace detail
+   {
+    // Standard streams setup: it must precede any output, so it is done once at startup instead of by each Print constructor
+    inline const bool standard_streams_setup = []
+     {
+      #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
+      std::ios_base::sync_with_stdio( false );
+      std::cout.tie( nullptr );
+      std::wcout.tie( nullptr );
+      std::cin.tie( nullptr );
+      std::wcin.tie( nullptr );
+      #endif
+
+      #ifdef PTC_ENABLE_FAST_STREAMS
+      print.installFastStreams();
+      #endif
+
+      return true;
+     }();
+   }
+
   #endif
-  inline Print <char16_t> print16;  // char16_t
-  inline Print <char32_t> print32;  // char32_t
+
+  // print_table
+  /**
+   * @brief Function used to print a table with ptc::print, aligning its columns (see Print::table). For example: ptc::print_table( rows, { "Name", "Value" } ).
+   * 
+   * @tparam Rows The type of the range of rows.
+   * @tparam Headers The type of the range of headers.
+   * @param rows The rows (ranges or tuple-like objects).
+   * @param headers The headers.
+   * @param os The stream in which you want to print the table.
+   */
+  template <class Rows, class Headers = std::initializer_list<std::string_view>>
+  inline void print_table( const Rows& rows, const Headers& headers = {}, std::ostream& os = std::cout )
+   {
+    print.table( os, rows, headers );
+   }
+
+  // TableWriter
+  /**
+   * @brief Class used to print with ptc::print a table whose rows are streamed, for example from an unbounded source. The column widths are fixed in advance, so that each row can be written as soon as it is given.
+   * 
+   */
+  class TableWriter
+   {
+    public:
+
+     // Constructor
+     /**
+      * @brief Construct a new TableWriter object.
+      * 
+      * @param widths The widths of the columns.
+      * @param os The stream in which you want to print the table.
+      */
+     explicit TableWriter( std::vector<std::size_t> widths, std::ostream& os = std::cout ):
+       widths( std::move( widths ) ),
+       stream( os )
+      {}
+
+     // header
+     /**
+      * @brief Method used to print the headers of the table, followed by a rule.
+      * 
+      * @tparam Args The types of the headers.
+      * @param names The headers.
+      */
+     template <class... Args>
+     void header( const Args&... names ) const
+      {
+       print.tableRow( stream, widths, std::forward_as_tuple( names... ), true );
+      }
+
+     // operator ()
+     /**
+      * @brief Operator used to print a row of the table.
+      * 
+      * @tparam Args The types of the cells.
+      * @param cells The cells.
+      */
+     template <class... Args>
+     void operator()( const Args&... cells ) const
+      {
+       print.tableRow( stream, widths, std::forward_as_tuple( cells... ) );
+      }
+
+    private:
+
+     std::vector<std::size_t> widths;
+     std::ostream& stream;
+   };
+
+  #ifdef PTC_HAS_LITERAL_LINES
+
+  // print_lit
+  /**
+   * @brief Function used to print with ptc::print a line made only of string literals, built at compile-time. For example: ptc::print_lit<"Starting", "server", "!">().
+   * 
+   * @tparam First The first literal.
+   * @tparam Args All the other literals.
+   * @param os The stream in which you want to print the output.
+   */
+  template <fixed_string First, fixed_string... Args>
+  inline void print_lit( std::ostream& os = std::cout )
+   {
+    print.literal<First, Args...>( os );
+   }
+
   #endif
+
+  //====================================================
+  //     Sampled printing
+  //====================================================
+
+  // EveryN
+  /**
+   * @brief Class used to store the state of a call site which prints once every "n" calls (see PTC_PRINT_EVERY_N): the 1st, the (n+1)th, the (2n+1)th... calls pass. It is constant-initialized, so a static object has no guard.
+   * 
+   */
+  class EveryN
+   {
+    public:
+
+     // pass
+     /**
+      * @brief Method used to count a call and check if it has to print, with a single relaxed atomic operation.
+      * 
+      * @param n The sampling period (0 means never).
+      * @return true If the call has to print.
+      * @return false Otherwise.
+      */
+     bool pass( std::uint64_t n ) noexcept
+      {
+       return n != 0 && count.fetch_add( 1, std::memory_order_relaxed ) % n == 0;
+      }
+
+    private:
+
+     std::atomic<std::uint64_t> count{ 0 };
+   };
+
+  // FirstN
+  /**
+   * @brief Class used to store the state of a call site which prints only its first "n" calls (see PTC_PRINT_FIRST_N). It is constant-initialized, so a static object has no guard.
+   * 
+   */
+  class FirstN
+   {
+    public:
+
+     // pass
+     /**
+      * @brief Method used to count a call and check if it has to print. Once "n" calls have passed, the check is a single relaxed atomic load, so that the call site does not write to a shared cache line anymore.
+      * 
+      * @param n The number of calls which print.
+      * @return true If the call has to print.
+      * @return false Otherwise.
+      */
+     bool pass( std::uint64_t n ) noexcept
+      {
+       return count.load( std::memory_order_relaxed ) < n && count.fetch_add( 1, std::memory_order_relaxed ) < n;
+      }
+
+    private:
+
+     std::atomic<std::uint64_t> count{ 0 };
+   };
+
+  // RateLimit
+  /**
+   * @brief Class used to store the state of a call site which prints at most "per_sec" lines per second (see PTC_PRINT_RATE). It is a token bucket with "per_sec" tokens (at least one), implemented with the generic cell rate algorithm: the only state is the theoretical arrival time of the next line, updated with a compare-and-swap. It is constant-initialized, so a static object has no guard.
+   * 
+   */
+  class RateLimit
+   {
+    public:
+
+     // pass
+     /**
+      * @brief Method used to check if a call has to print and, if so, to take its token. Rejected calls cost a clock read and a single relaxed atomic load.
+      * 
+      * @param per_sec The maximum number of lines per second.
+      * @return true If the call has to print.
+      * @return false Otherwise.
+      */
+     bool pass( double per_sec ) noexcept
+      {
+       if ( ! ( per_sec > 0 ) ) return false;
+
+       const auto interval = static_cast<std::int64_t>( 1e9 / per_sec );
+       const auto tolerance = ( per_sec > 1 ? static_cast<std::int64_t>( per_sec ) - 1 : 0 ) * interval;
+       const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+
+       std::int64_t expected = next.load( std::memory_order_relaxed );
+       while( true )
+        {
+         const std::int64_t start = expected > now ? expected : now;
+         if ( start - now > tolerance ) return false;
+         if ( next.compare_exchange_weak( expected, start + interval, std::memory_order_relaxed ) ) return true;
+        }
+      }
+
+    private:
+
+     std::atomic<std::int64_t> next{ 0 };
+   };
  }
 
+//====================================================
+//     Sampled printing macros
+//====================================================
+
+// Macros are needed to give each call site its own static state (as the glog LOG_EVERY_N family does): the
+// check is done before the arguments are evaluated and formatted and before the Print mutex is taken.
+
+// PTC_PRINT_EVERY_N
+/**
+ * @brief Macro used to print with ptc::print once every "n" executions of the call site, starting from the first one.
+ * 
+ */
+#define PTC_PRINT_EVERY_N( n, ... ) \
+  do { static ::ptc::EveryN ptc_site; if ( ptc_site.pass( n ) ) ::ptc::print( __VA_ARGS__ ); } while( false )
+
+// PTC_PRINT_FIRST_N
+/**
+ * @brief Macro used to print with ptc::print only the first "n" executions of the call site.
+ * 
+ */
+#define PTC_PRINT_FIRST_N( n, ... ) \
+  do { static ::ptc::FirstN ptc_site; if ( ptc_site.pass( n ) ) ::ptc::print( __VA_ARGS__ ); } while( false )
+
+// PTC_PRINT_RATE
+/**
+ * @brief Macro used to print with ptc::print at most "per_sec" lines per second from the call site, with bursts of up to "per_sec" lines.
+ * 
+ */
+#define PTC_PRINT_RATE( per_sec, ... ) \
+  do { static ::ptc::RateLimit ptc_site; if ( ptc_site.pass( per_sec ) ) ::ptc::print( __VA_ARGS__ ); } while( false )
+
 #endif
\ No newline at end of file
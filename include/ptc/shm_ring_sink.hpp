@@ -0,0 +1,425 @@
+//====================================================
+//     File data
+//====================================================
+/**
+ * @file shm_ring_sink.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#pragma once
+#ifndef PYTHON_TO_CPP_SHM_RING_SINK_HPP
+#define PYTHON_TO_CPP_SHM_RING_SINK_HPP
+
+#if defined( _WIN32 )
+#error "ptc::shm_ring_sink requires POSIX shared memory."
+#endif
+
+//====================================================
+//     Headers
+//====================================================
+
+// Standard headers
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+
+// POSIX headers
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+//====================================================
+//     Namespaces
+//====================================================
+namespace ptc
+ {
+  inline namespace detail
+   {
+    //====================================================
+    //     Shared memory layout
+    //====================================================
+
+    // ShmRingHeader
+    /**
+     * @brief Struct placed at the beginning of the shared memory object. Positions grow forever and are reduced modulo the capacity, which is a power of two. Each record starts with an 8 bytes word (length << 8 | kind) which is written last by its producer; the consumer zeroes the consumed bytes before moving the read position, so that an unpublished record always reads as zero. There is no recovery if a producer dies between reserving a record and publishing it: its word stays zero, so the consumer stops at it forever and, once the ring fills up, every later line is dropped (the ring must then be unlinked and recreated).
+     *
+     */
+    struct ShmRingHeader
+     {
+      static constexpr std::uint64_t magic_value = 0x7074632d72696e67; // "ptc-ring"
+
+      std::atomic<std::uint64_t> magic;
+      std::uint64_t capacity;
+      alignas( 64 ) std::atomic<std::uint64_t> reserve;
+      alignas( 64 ) std::atomic<std::uint64_t> read;
+      alignas( 64 ) std::atomic<std::uint64_t> written;
+      std::atomic<std::uint64_t> dropped;
+     };
+
+    // Record kinds
+    constexpr std::uint64_t shm_record_data = 1;
+    constexpr std::uint64_t shm_record_padding = 2;
+    constexpr std::size_t shm_record_header = sizeof( std::uint64_t );
+
+    static_assert( std::atomic<std::uint64_t>::is_always_lock_free, "Shared memory rings require lock-free 64-bit atomics." );
+
+    // ShmRing
+    /**
+     * @brief Class used to create or open a shared memory ring and map it into the process.
+     *
+     */
+    class ShmRing
+     {
+      public:
+
+       // Constructor
+       /**
+        * @brief Create the shared memory object "name" with the given data capacity (rounded up to a power of two), or open it if it already exists.
+        *
+        * @param name The name of the shared memory object (for example "/ptc-log").
+        * @param capacity The size of the data area, used only if the object is created.
+        * @param create If false the object must already exist.
+        */
+       ShmRing( const std::string& name, std::size_t capacity, bool create )
+        {
+         std::size_t rounded = 64;
+         while( rounded < capacity ) rounded <<= 1;
+
+         // Creating a new object, or opening an existing one
+         bool owner = false;
+         int fd = -1;
+         if ( create )
+          {
+           fd = ::shm_open( name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+           owner = fd >= 0;
+           if ( ! owner && errno != EEXIST ) fail( "shm_open", name );
+          }
+         if ( ! owner )
+          {
+           fd = ::shm_open( name.c_str(), O_RDWR, 0600 );
+           if ( fd < 0 ) fail( "shm_open", name );
+          }
+
+         if ( owner )
+          {
+           if ( ::ftruncate( fd, static_cast<off_t>( sizeof( ShmRingHeader ) + rounded ) ) != 0 )
+            {
+             ::close( fd );
+             ::shm_unlink( name.c_str() );
+             fail( "ftruncate", name );
+            }
+          }
+         else
+          {
+           // Waiting for the creator to set the size
+           struct stat info{};
+           for( int i = 0; i < 1000 && ( ::fstat( fd, &info ) != 0 || static_cast<std::size_t>( info.st_size ) <= sizeof( ShmRingHeader ) ); ++i ) std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+           if ( static_cast<std::size_t>( info.st_size ) <= sizeof( ShmRingHeader ) )
+            {
+             ::close( fd );
+             throw std::runtime_error( "ptc::shm_ring: \"" + name + "\" is not initialized." );
+            }
+           rounded = static_cast<std::size_t>( info.st_size ) - sizeof( ShmRingHeader );
+          }
+
+         size = sizeof( ShmRingHeader ) + rounded;
+         void* memory = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+         ::close( fd );
+         if ( memory == MAP_FAILED ) fail( "mmap", name );
+         header = static_cast<ShmRingHeader*>( memory );
+         data = static_cast<char*>( memory ) + sizeof( ShmRingHeader );
+
+         // Initializing the header (the mapping is zero-filled), or waiting for the creator to do it
+         if ( owner )
+          {
+           header -> capacity = rounded;
+           header -> magic.store( ShmRingHeader::magic_value, std::memory_order_release );
+          }
+         else
+          {
+           for( int i = 0; i < 1000 && header -> magic.load( std::memory_order_acquire ) != ShmRingHeader::magic_value; ++i ) std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+           if ( header -> magic.load( std::memory_order_acquire ) != ShmRingHeader::magic_value || header -> capacity != rounded )
+            {
+             ::munmap( memory, size );
+             throw std::runtime_error( "ptc::shm_ring: \"" + name + "\" is not a ptc ring." );
+            }
+          }
+        }
+
+       // Destructor
+       ~ShmRing()
+        {
+         ::munmap( header, size );
+        }
+
+       ShmRing( const ShmRing& ) = delete;
+       ShmRing& operator=( const ShmRing& ) = delete;
+
+       // push
+       /**
+        * @brief Method used to publish a record. It never blocks: if there is not enough free space the record is dropped and counted. Safe for any number of concurrent producers, in any process.
+        *
+        * @param bytes The record content.
+        * @param length The record length.
+        * @return true If the record has been published.
+        * @return false If it has been dropped.
+        */
+       bool push( const char* bytes, std::size_t length )
+        {
+         const std::uint64_t capacity = header -> capacity;
+         const std::uint64_t record = align( shm_record_header + length );
+
+         // Reserving the space (and the padding up to the end of the data area, if needed)
+         std::uint64_t start = header -> reserve.load( std::memory_order_relaxed ), padding = 0;
+         do
+          {
+           const std::uint64_t offset = start & ( capacity - 1 );
+           padding = offset + record > capacity ? capacity - offset : 0;
+           if ( record > capacity / 2 || start + padding + record - header -> read.load( std::memory_order_acquire ) > capacity )
+            {
+             header -> dropped.fetch_add( 1, std::memory_order_relaxed );
+             return false;
+            }
+          }
+         while( ! header -> reserve.compare_exchange_weak( start, start + padding + record, std::memory_order_acq_rel, std::memory_order_relaxed ) );
+
+         // Writing the padding and the record, then publishing their headers
+         if ( padding > 0 ) word( start ).store( padding << 8 | shm_record_padding, std::memory_order_release );
+         const std::uint64_t position = start + padding;
+         std::memcpy( data + ( position & ( capacity - 1 ) ) + shm_record_header, bytes, length );
+         word( position ).store( static_cast<std::uint64_t>( length ) << 8 | shm_record_data, std::memory_order_release );
+         header -> written.fetch_add( 1, std::memory_order_relaxed );
+
+         return true;
+        }
+
+       // pop
+       /**
+        * @brief Method used to consume the next record, if published. Only one consumer at a time is supported.
+        *
+        * @param out The string in which the record content is stored.
+        * @return true If a record has been consumed.
+        * @return false If there is no published record.
+        */
+       bool pop( std::string& out )
+        {
+         const std::uint64_t capacity = header -> capacity;
+         std::uint64_t position = header -> read.load( std::memory_order_relaxed );
+         while( true )
+          {
+           const std::uint64_t value = word( position ).load( std::memory_order_acquire );
+           if ( value == 0 ) return false;
+
+           const std::uint64_t kind = value & 0xff;
+           const std::uint64_t length = value >> 8;
+           const std::uint64_t record = kind == shm_record_padding ? length : align( shm_record_header + length );
+           char* begin = data + ( position & ( capacity - 1 ) );
+           if ( kind == shm_record_data ) out.assign( begin + shm_record_header, static_cast<std::size_t>( length ) );
+
+           // Releasing the space
+           std::memset( begin + shm_record_header, 0, static_cast<std::size_t>( record - shm_record_header ) );
+           word( position ).store( 0, std::memory_order_relaxed );
+           position += record;
+           header -> read.store( position, std::memory_order_release );
+           if ( kind == shm_record_data ) return true;
+          }
+        }
+
+       // Counters
+       std::uint64_t written() const { return header -> written.load( std::memory_order_relaxed ); }
+       std::uint64_t dropped() const { return header -> dropped.load( std::memory_order_relaxed ); }
+       std::uint64_t capacity() const { return header -> capacity; }
+
+      private:
+
+       static std::uint64_t align( std::uint64_t value ) { return ( value + 7 ) & ~std::uint64_t( 7 ); }
+
+       std::atomic<std::uint64_t>& word( std::uint64_t position ) const
+        {
+         return *reinterpret_cast<std::atomic<std::uint64_t>*>( data + ( position & ( header -> capacity - 1 ) ) );
+        }
+
+       [[noreturn]] static void fail( const char* call, const std::string& name )
+        {
+         throw std::runtime_error( "ptc::shm_ring: " + std::string( call ) + " failed for \"" + name + "\": " + std::strerror( errno ) );
+        }
+
+       ShmRingHeader* header = nullptr;
+       char* data = nullptr;
+       std::size_t size = 0;
+     };
+
+    // ShmRingBuffer
+    /**
+     * @brief Stream buffer which publishes each line written to it as a record of a ShmRing. Like any std::streambuf it is not synchronized: concurrent writers must be serialized (ptc::print already does it).
+     *
+     */
+    class ShmRingBuffer: public std::streambuf
+     {
+      public:
+
+       ShmRingBuffer( const std::string& name, std::size_t capacity ): ring( name, capacity, true ) {}
+       ~ShmRingBuffer() override { sync(); }
+
+       ShmRing ring;
+
+      protected:
+
+       int_type overflow( int_type c ) override
+        {
+         if ( traits_type::eq_int_type( c, traits_type::eof() ) ) return traits_type::not_eof( c );
+         line.push_back( traits_type::to_char_type( c ) );
+         if ( traits_type::to_char_type( c ) == '\n' ) publish();
+         return c;
+        }
+
+       std::streamsize xsputn( const char* s, std::streamsize n ) override
+        {
+         line.append( s, static_cast<std::size_t>( n ) );
+         if ( std::char_traits<char>::find( s, static_cast<std::size_t>( n ), '\n' ) ) publish();
+         return n;
+        }
+
+       int sync() override
+        {
+         if ( ! line.empty() )
+          {
+           ring.push( line.data(), line.size() );
+           line.clear();
+          }
+         return 0;
+        }
+
+      private:
+
+       // Publishing each complete line as a separate record
+       void publish()
+        {
+         std::size_t begin = 0, end = 0;
+         while( ( end = line.find( '\n', begin ) ) != std::string::npos )
+          {
+           ring.push( line.data() + begin, end + 1 - begin );
+           begin = end + 1;
+          }
+         line.erase( 0, begin );
+        }
+
+       std::string line;
+     };
+   }
+
+  //====================================================
+  //     shm_ring_sink class
+  //====================================================
+  /**
+   * @brief Output stream which hands each written line to a local consumer process through a POSIX shared memory ring (see tools/shm_tail.cpp), without pipes or sockets. Any number of sinks, in any process, can write to the same ring. Producers never block: if the consumer falls behind, lines which do not fit are dropped and counted. A producer killed while writing a line blocks the ring for good (see ShmRingHeader).
+   *
+   */
+  class shm_ring_sink: private ShmRingBuffer, public std::ostream
+   {
+    public:
+
+     static constexpr std::size_t default_capacity = 1 << 20;
+
+     // Constructor
+     /**
+      * @brief Create the shared memory ring "name", or open it if it already exists.
+      *
+      * @param name The name of the shared memory object (for example "/ptc-log").
+      * @param capacity The size of the ring in bytes, rounded up to a power of two. Used only if the ring is created.
+      */
+     explicit shm_ring_sink( const std::string& name, std::size_t capacity = default_capacity ):
+      ShmRingBuffer( name, capacity ),
+      std::ostream( static_cast<ShmRingBuffer*>( this ) ),
+      name_( name )
+      {}
+
+     // written
+     /**
+      * @brief Method used to get the number of lines published to the ring by all its producers.
+      *
+      * @return std::uint64_t The number of published lines.
+      */
+     std::uint64_t written() const { return ring.written(); }
+
+     // dropped
+     /**
+      * @brief Method used to get the number of lines dropped by all the producers of the ring because it was full.
+      *
+      * @return std::uint64_t The number of dropped lines.
+      */
+     std::uint64_t dropped() const { return ring.dropped(); }
+
+     // name
+     /**
+      * @brief Method used to get the name of the shared memory object.
+      *
+      * @return const std::string& The name.
+      */
+     const std::string& name() const { return name_; }
+
+     // unlink
+     /**
+      * @brief Method used to remove the name of the shared memory object. The memory is released when every process has unmapped it.
+      *
+      */
+     void unlink() const { ::shm_unlink( name_.c_str() ); }
+
+    private:
+
+     std::string name_;
+   };
+
+  //====================================================
+  //     shm_ring_reader class
+  //====================================================
+  /**
+   * @brief Class used to consume the lines of a ring written by shm_ring_sink objects. Only one reader at a time is supported.
+   *
+   */
+  class shm_ring_reader
+   {
+    public:
+
+     // Constructor
+     /**
+      * @brief Open the existing shared memory ring "name".
+      *
+      * @param name The name of the shared memory object.
+      */
+     explicit shm_ring_reader( const std::string& name ): ring( name, 0, false ) {}
+
+     // read
+     /**
+      * @brief Method used to read the next line, if any. It never blocks.
+      *
+      * @param line The string in which the line (including its newline, if any) is stored.
+      * @return true If a line has been read.
+      * @return false If the ring is empty.
+      */
+     bool read( std::string& line ) { return ring.pop( line ); }
+
+     // Counters
+     std::uint64_t written() const { return ring.written(); }
+     std::uint64_t dropped() const { return ring.dropped(); }
+
+    private:
+
+     ShmRing ring;
+   };
+ }
+
+#endif
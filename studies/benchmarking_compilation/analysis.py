@@ -60,7 +60,9 @@ def get_size_of( executable ):
     
     command = "wc -c < bin/{}".format( executable )
     output = subprocess.check_output( [ "wc", "-c", "bin/{}".format( executable ) ] )
-    if "fmt" in executable or "ptc" in executable:
+    if "module" in executable:
+        output = str( output )[2:-18]
+    elif "fmt" in executable or "ptc" in executable:
         output = str( output )[2:-11]
     elif "printf" in executable or "stdout" in executable or "pprint" in executable:
         output = str( output )[2:-14]
@@ -83,6 +85,7 @@ def get_time_of_stats( program ):
     """
     
     # Extra info for compilation flags
+    standard = "-std=c++17"
     additional_flags = "-O3"
     ldflags = ""
     if "fmt" in program:
@@ -92,8 +95,14 @@ def get_time_of_stats( program ):
     iter_mean = np.array( [] )
     if not os.path.exists( "bin" ):
         os.makedirs( "bin" )
+
+    # The module interface is built once (untimed), like it would be in a real project
+    if "module" in program:
+        standard = "-std=c++20 -fmodules-ts"
+        subprocess.run( "g++ {} {} -x c++ -c ../../include/ptc/print.cppm -o bin/ptc_interface.o".format( standard, additional_flags ).split(), check = True )
+        ldflags = "bin/ptc_interface.o"
     for n in range( int( args.niter ) ):
-        get_time = get_time_of( "g++ -std=c++17 {} {} {} -o bin/{}".format( additional_flags, program, ldflags, program[9:-4] ) )
+        get_time = get_time_of( "g++ {} {} {} {} -o bin/{}".format( standard, additional_flags, program, ldflags, program[9:-4] ) )
         iter_mean = np.append( iter_mean, get_time )
     mean, std = iter_mean.mean(), iter_mean.std()
     
@@ -178,13 +187,17 @@ def main():
         "programs/stdout.cpp", # stdout
         "programs/pprint.cpp"  # pprint
     ]
+    if args.module == "yes":
+        programs.append( "programs/ptc_module.cpp" ) # ptc (import ptc;)
     
     # Launching benchmarks
     print( "Generating data for compile time benchmarks:" )
     for index, program in enumerate( tqdm( programs ) ):
         mean, std = get_time_of_stats( program )
         data_programs[ index ] =  program[9:-4]
-        if "ptc" in program:
+        if "module" in program:
+            data_programs[ index ] =  "import ptc"
+        elif "ptc" in program:
             data_programs[ index ] =  "ptc::print"
         elif "fmt" in program:
             data_programs[ index ] =  "fmt::print"
@@ -221,6 +234,7 @@ if __name__ == "__main__":
     parser.add_argument( "--niter", default = 100, help = "The number of benchmarking iterations." )
     parser.add_argument( "--plots", default = "no", help = "Produce or not plots." )
     parser.add_argument( "--macro", default = "no", help = "Enable or disable macro usage." )
+    parser.add_argument( "--module", default = "no", help = "Benchmark also the ptc C++20 module (requires module support in g++)." )
     args = parser.parse_args()
     
     # Main commands
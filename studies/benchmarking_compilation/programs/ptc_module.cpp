@@ -0,0 +1,6 @@
+import ptc;
+
+int main()
+ {
+  ptc::print( "Testing", 123, "print", '!' );
+ }
@@ -1,5 +1,13 @@
 #!/bin/bash
 
+# $1 = "module": benchmark also the "import ptc;" program (requires C++20 modules support).
+
+# Extra option for module usage
+module="no"
+if [ "$1" == "module" ] ; then
+    module="yes"
+fi
+
 # Setting-up environment
 sudo cpupower frequency-set --governor performance > /dev/null 2>&1                  # Set scaling_governor to "performance"
 echo "1" | sudo tee /sys/devices/system/cpu/intel_pstate/no_turbo > /dev/null 2>&1   # Disable Turboboost
@@ -11,7 +19,8 @@ echo 0 | sudo tee /proc/sys/kernel/randomize_va_space > /dev/null 2>&1
 ./analysis.py \
 --niter=100 \
 --plots=yes \
---macro=yes
+--macro=yes \
+--module=${module}
 
 # Setting-up environment back to old settings
 sudo cpupower frequency-set --governor powersave > /dev/null 2>&1
@@ -35,14 +35,64 @@ def set_y_label( time_type ):
         'Real time'
         >>> set_y_label( "cpu_time" )
         'CPU time'
+        >>> set_y_label( "allocs" )
+        'Allocations'
+        >>> set_y_label( "bytes" )
+        'Allocated bytes'
     """
     
     if time_type == "real_time":
         return "Real time"
     elif time_type == "cpu_time":
         return "CPU time"
+    elif time_type == "allocs":
+        return "Allocations"
+    elif time_type == "bytes":
+        return "Allocated bytes"
     return ""
 
+#################################################
+#     set_y_unit
+#################################################
+def set_y_unit( time_type ):
+    """
+    Function used to get the unit of the input y label.
+
+    Args:
+        time_type (str): the input y label.
+
+    Returns:
+        str: the unit of the input y label.
+    
+    Testing:
+        >>> set_y_unit( "real_time" )
+        'ns'
+        >>> set_y_unit( "allocs" )
+        'per iteration'
+    """
+    
+    if time_type in [ "allocs", "bytes" ]:
+        return "per iteration"
+    return "ns"
+
+#################################################
+#     has_allocations
+#################################################
+def has_allocations( data ):
+    """
+    Function used to check if a dataset contains the allocation counters (benchmarks run with PTC_BENCHMARK_ALLOCATIONS).
+
+    Args:
+        data (json file): the input dataset.
+
+    Returns:
+        bool: True if the dataset contains the allocation counters.
+    """
+    
+    with open( data ) as f:
+        data = json.load( f )
+    return any( "allocs" in d for d in data[ "benchmarks" ] )
+
 #################################################
 #     set_x_ticks_label
 #################################################
@@ -147,11 +197,14 @@ def plotter( data, time_type ):
 
     # Adding mean value inside each chart
     for i in range( counter ):
-        ax.text( -0.2 + i , 70, round( mean[ i ] ), color = "white", fontweight = "bold" )
+        if set_y_unit( time_type ) == "ns":
+            ax.text( -0.2 + i , 70, round( mean[ i ] ), color = "white", fontweight = "bold" )
+        else:
+            ax.text( -0.2 + i , mean[ i ] / 2, round( mean[ i ], 2 ), color = "white", fontweight = "bold" )
         
     # Plot settings
     ax.set_xlabel( "Object / function" )
-    ax.set_ylabel( "{} (ns)".format( set_y_label( time_type ) ) )
+    ax.set_ylabel( "{} ({})".format( set_y_label( time_type ), set_y_unit( time_type ) ) )
     current_date = date.today()
     if "Real" in ax.get_ylabel():
         ax.set_title( r'''$\bf{Real \ time \ benchmarks}$ (%(feature)s)'''
@@ -161,6 +214,14 @@ def plotter( data, time_type ):
         ax.set_title( r'''$\bf{CPU \ time \ benchmarks}$ (%(feature)s)'''
                       "\n"
                       r''' Date: (%(date)s)'''% { "feature": feature_name, "date": current_date })
+    elif "Allocations" in ax.get_ylabel():
+        ax.set_title( r'''$\bf{Allocations \ benchmarks}$ (%(feature)s)'''
+                      "\n"
+                      r''' Date: (%(date)s)'''% { "feature": feature_name, "date": current_date })
+    elif "bytes" in ax.get_ylabel():
+        ax.set_title( r'''$\bf{Allocated \ bytes \ benchmarks}$ (%(feature)s)'''
+                      "\n"
+                      r''' Date: (%(date)s)'''% { "feature": feature_name, "date": current_date })
     ax.yaxis.grid( True )
     ax.set_axisbelow( True )
         
@@ -187,6 +248,9 @@ def plotter( data, time_type ):
 def main():
     plotter( args.data, "real_time" )
     plotter( args.data, "cpu_time" )
+    if has_allocations( args.data ):
+        plotter( args.data, "allocs" )
+        plotter( args.data, "bytes" )
 
 if __name__ == "__main__":
 
@@ -21,12 +21,65 @@
 #include <vector>
 #include <stack>
 #include <chrono>
+#include <iomanip>
+#include <cctype>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 
 //====================================================
 //     Namespace directives
 //====================================================
 namespace bm = benchmark;
 
+//====================================================
+//     Allocation counting
+//====================================================
+
+// Defining PTC_BENCHMARK_ALLOCATIONS (e.g. with "./run.sh allocations") replaces the global operator new and reports the heap allocations of each benchmark as "allocs" and "bytes" per iteration counters.
+#ifdef PTC_BENCHMARK_ALLOCATIONS
+
+// Counters
+static std::atomic<std::size_t> allocations{ 0 }, allocated_bytes{ 0 };
+
+// operator new
+void* operator new( std::size_t size )
+ {
+  allocations.fetch_add( 1, std::memory_order_relaxed );
+  allocated_bytes.fetch_add( size, std::memory_order_relaxed );
+  if ( void* ptr = std::malloc( size > 0 ? size : 1 ) ) return ptr;
+  throw std::bad_alloc();
+ }
+
+// operator delete (GCC does not see that operator new uses malloc once they are inlined)
+#if defined( __GNUC__ ) && ! defined( __clang__ ) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete( void* ptr ) noexcept { std::free( ptr ); }
+void operator delete( void* ptr, std::size_t ) noexcept { std::free( ptr ); }
+#if defined( __GNUC__ ) && ! defined( __clang__ ) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// counted
+template <void ( *Function )( bm::State& )>
+static void counted( bm::State& state )
+ {
+  const std::size_t allocations_start = allocations.load(), bytes_start = allocated_bytes.load();
+  Function( state );
+  state.counters[ "allocs" ] = bm::Counter( static_cast<double>( allocations.load() - allocations_start ), bm::Counter::kAvgIterations );
+  state.counters[ "bytes" ] = bm::Counter( static_cast<double>( allocated_bytes.load() - bytes_start ), bm::Counter::kAvgIterations );
+ }
+
+#define PTC_BENCHMARK( function ) BENCHMARK( counted<function> ) -> Name( #function )
+
+#else
+
+#define PTC_BENCHMARK( function ) BENCHMARK( function )
+
+#endif
+
 //====================================================
 //     ptc::print setters
 //====================================================
@@ -97,6 +150,16 @@ static void ptc_print_standard( bm::State& state )
   for ( auto _ : state ) ptc::print( std::cout, "Testing", 123, "print", '!' );
  }
 
+#ifdef PTC_HAS_LITERAL_LINES
+
+// ptc_print_lit
+static void ptc_print_lit( bm::State& state ) 
+ {
+  for ( auto _ : state ) ptc::print_lit<"Testing", "print", "!">( std::cout );
+ }
+
+#endif
+
 // ptc_print_str
 static void ptc_print_str( bm::State& state ) 
  {
@@ -119,12 +182,83 @@ static void ptc_print_StringConverter_wchar_t( bm::State& state )
 //      ptc::print utils
 //====================================================
 
-// ptc_print_standard
+// ptc_ptr
 static void ptc_ptr( bm::State& state ) 
  {
   int a = 4;
   int* p = &a;
-  for ( auto _ : state ) ptc::ptr( p );
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::ptr( p ) );
+ }
+
+// packet
+static const std::vector<unsigned char> packet = []
+ {
+  std::vector<unsigned char> bytes( 1500 );
+  for ( std::size_t i = 0; i < bytes.size(); ++i ) bytes[ i ] = static_cast<unsigned char>( i * 31 );
+  return bytes;
+ }();
+
+// ptc_hex_bytes
+static void ptc_hex_bytes( bm::State& state ) 
+ {
+  std::ostringstream oss;
+  for ( auto _ : state ) 
+   {
+    oss.str( "" );
+    oss << ptc::hex_bytes( packet );
+    bm::DoNotOptimize( oss );
+   }
+ }
+
+// std_hex_bytes
+static void std_hex_bytes( bm::State& state ) 
+ {
+  std::ostringstream oss;
+  for ( auto _ : state ) 
+   {
+    oss.str( "" );
+    oss << std::hex << std::setfill( '0' );
+    for ( unsigned char byte: packet ) oss << std::setw( 2 ) << static_cast<int>( byte );
+    bm::DoNotOptimize( oss );
+   }
+ }
+
+// ptc_hexdump
+static void ptc_hexdump( bm::State& state ) 
+ {
+  std::ostringstream oss;
+  for ( auto _ : state ) 
+   {
+    oss.str( "" );
+    oss << ptc::hexdump( packet );
+    bm::DoNotOptimize( oss );
+   }
+ }
+
+// std_hexdump
+static void std_hexdump( bm::State& state ) 
+ {
+  std::ostringstream oss;
+  for ( auto _ : state ) 
+   {
+    oss.str( "" );
+    oss << std::hex << std::setfill( '0' );
+    for ( std::size_t offset = 0; offset < packet.size(); offset += 16 )
+     {
+      if ( offset != 0 ) oss << '\n';
+      oss << std::setw( 8 ) << offset << ' ';
+      for ( std::size_t i = offset; i < offset + 16; ++i )
+       {
+        if ( i % 8 == 0 ) oss << ' ';
+        if ( i < packet.size() ) oss << std::setw( 2 ) << static_cast<int>( packet[ i ] ) << ' ';
+        else oss << "   ";
+       }
+      oss << " |";
+      for ( std::size_t i = offset; i < offset + 16 && i < packet.size(); ++i ) oss << ( std::isprint( packet[ i ] ) ? static_cast<char>( packet[ i ] ) : '.' );
+      oss << '|';
+     }
+    bm::DoNotOptimize( oss );
+   }
  }
 
 //====================================================
@@ -229,46 +363,53 @@ static void fmt_print_file( bm::State& state )
 //====================================================
 
 // ptc::print setters
-//BENCHMARK( ptc_print_setEnd );
-//BENCHMARK( ptc_print_setSep );
-//BENCHMARK( ptc_print_setFlush );
-//BENCHMARK( ptc_print_setPattern );
+//PTC_BENCHMARK( ptc_print_setEnd );
+//PTC_BENCHMARK( ptc_print_setSep );
+//PTC_BENCHMARK( ptc_print_setFlush );
+//PTC_BENCHMARK( ptc_print_setPattern );
 
 // ptc::print getters
-//BENCHMARK( ptc_print_getEnd );
-//BENCHMARK( ptc_print_getSep );
-//BENCHMARK( ptc_print_getFlush );
-//BENCHMARK( ptc_print_getPattern );
+//PTC_BENCHMARK( ptc_print_getEnd );
+//PTC_BENCHMARK( ptc_print_getSep );
+//PTC_BENCHMARK( ptc_print_getFlush );
+//PTC_BENCHMARK( ptc_print_getPattern );
 
 // ptc::print other 
-//BENCHMARK( ptc_print_standard );
-//BENCHMARK( ptc_print_str );
-//BENCHMARK( ptc_print_StringConverter_char );
-//BENCHMARK( ptc_print_StringConverter_wchar_t );
+//PTC_BENCHMARK( ptc_print_standard );
+//PTC_BENCHMARK( ptc_print_str );
+#ifdef PTC_HAS_LITERAL_LINES
+//PTC_BENCHMARK( ptc_print_lit );
+#endif
+//PTC_BENCHMARK( ptc_print_StringConverter_char );
+//PTC_BENCHMARK( ptc_print_StringConverter_wchar_t );
 
 // non built-in types
-//BENCHMARK( ptc_print_complex );
-//BENCHMARK( ptc_print_vector );
-//BENCHMARK( ptc_print_stack );
-//BENCHMARK( ptc_print_duration );
+//PTC_BENCHMARK( ptc_print_complex );
+//PTC_BENCHMARK( ptc_print_vector );
+//PTC_BENCHMARK( ptc_print_stack );
+//PTC_BENCHMARK( ptc_print_duration );
 
 // utils
-//BENCHMARK( ptc_ptr );
+PTC_BENCHMARK( ptc_ptr );
+//PTC_BENCHMARK( ptc_hex_bytes );
+//PTC_BENCHMARK( std_hex_bytes );
+//PTC_BENCHMARK( ptc_hexdump );
+//PTC_BENCHMARK( std_hexdump );
 
 //====================================================
 //     Comparison with other libraries
 //====================================================
 
 // stdout
-BENCHMARK( ptc_print_stdout );
-BENCHMARK( fmt_print_stdout );
-//BENCHMARK( std_cout_stdout );
-BENCHMARK( printf_stdout );
-BENCHMARK( pprint_print_stdout );
+PTC_BENCHMARK( ptc_print_stdout );
+PTC_BENCHMARK( fmt_print_stdout );
+//PTC_BENCHMARK( std_cout_stdout );
+PTC_BENCHMARK( printf_stdout );
+PTC_BENCHMARK( pprint_print_stdout );
 
 // file writing
-//BENCHMARK( ptc_print_file );
-//BENCHMARK( fmt_print_file );
-//BENCHMARK( std_file );
+//PTC_BENCHMARK( ptc_print_file );
+//PTC_BENCHMARK( fmt_print_file );
+//PTC_BENCHMARK( std_file );
 
 BENCHMARK_MAIN();
@@ -1,6 +1,7 @@
 #!/bin/bash
 
 # $1 = "macro": run benchmarks with macro options enabled.
+# $1 = "allocations": run benchmarks counting the heap allocations of each one.
 
 # Creating directories
 mkdir -p data
@@ -8,6 +9,8 @@ mkdir -p data
 # Extra option for macro usage
 if [ "$1" == "macro" ] ; then
     sed -i '4s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' benchmarking.cpp
+elif [ "$1" == "allocations" ] ; then
+    sed -i '4s/.*/#define PTC_BENCHMARK_ALLOCATIONS\n/' benchmarking.cpp
 fi
 
 # Compiling
@@ -35,7 +38,7 @@ sync
 echo 2 | sudo tee /proc/sys/kernel/randomize_va_space > /dev/null 2>&1
 
 # Extra option for macro usage
-if [ "$1" == "macro" ] ; then
+if [ "$1" == "macro" ] || [ "$1" == "allocations" ] ; then
     sed -i '4d' benchmarking.cpp
 fi
 
@@ -38,6 +38,22 @@ run_all_tests() {
     echo ""
     ./build/tests/ptcprint_unit_tests
 
+    # Stats tests
+    echo ""
+    echo "======================================================"
+    echo "     STATS TESTS"
+    echo "======================================================"
+    echo ""
+    ./build/tests/ptcprint_stats_tests
+
+    # Module tests
+    echo ""
+    echo "======================================================"
+    echo "     MODULE TESTS"
+    echo "======================================================"
+    echo ""
+    ( cd build && ctest -R module --output-on-failure )
+
     # Include tests
     echo ""
     echo "======================================================"
@@ -65,11 +81,13 @@ elif [ "$1" == "macro" ] ; then
     sed -i '4s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/system_tests.cpp
     sed -i '5s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/threading_tests.cpp
     sed -i '7s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/unit_tests.cpp
+    sed -i '7s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/stats_tests.cpp
     cmake --build build
     run_all_tests
     sed -i '4d' tests/system_tests.cpp
     sed -i '5d' tests/threading_tests.cpp
     sed -i '7d' tests/unit_tests.cpp
+    sed -i '7d' tests/stats_tests.cpp
 else
     echo "======================================================"
     echo "     COMPILING"
@@ -86,11 +104,13 @@ else
     sed -i '4s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/system_tests.cpp
     sed -i '5s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/threading_tests.cpp
     sed -i '7s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/unit_tests.cpp
+    sed -i '7s/.*/#define PTC_ENABLE_PERFORMANCE_IMPROVEMENTS\n/' tests/stats_tests.cpp
     cmake --build build
     run_all_tests
     sed -i '4d' tests/system_tests.cpp
     sed -i '5d' tests/threading_tests.cpp
     sed -i '7d' tests/unit_tests.cpp
+    sed -i '7d' tests/stats_tests.cpp
 fi
 
 # Cppcheck
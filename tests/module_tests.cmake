@@ -0,0 +1,35 @@
+# Script used to build the ptc module interface and, with STAGE=importer, an importer of it. Run with:
+# cmake -DCOMPILER=<compiler> -DCOMPILER_ID=<GNU|Clang> -DSOURCE_DIR=<tests dir> -DSTAGE=<interface|importer> -P module_tests.cmake
+cmake_minimum_required( VERSION 3.15 )
+
+# run
+function( run )
+    execute_process( COMMAND ${ARGN} RESULT_VARIABLE result )
+    if( NOT result EQUAL 0 )
+        string( REPLACE ";" " " command "${ARGN}" )
+        message( FATAL_ERROR "Failed: ${command}" )
+    endif()
+endfunction()
+
+# Paths and flags
+set( INTERFACE "${SOURCE_DIR}/../include/ptc/print.cppm" )
+set( IMPORTER "${SOURCE_DIR}/module_tests.cpp" )
+set( FLAGS -std=c++20 -pthread )
+
+# Module interface
+if( COMPILER_ID STREQUAL "GNU" )
+    run( ${COMPILER} ${FLAGS} -fmodules-ts -x c++ -c ${INTERFACE} -o print.o )
+    set( IMPORT_FLAGS -fmodules-ts )
+elseif( COMPILER_ID MATCHES "Clang" )
+    run( ${COMPILER} ${FLAGS} -x c++-module --precompile ${INTERFACE} -o ptc.pcm )
+    run( ${COMPILER} ${FLAGS} -c ptc.pcm -o print.o )
+    set( IMPORT_FLAGS -fmodule-file=ptc=ptc.pcm )
+else()
+    message( FATAL_ERROR "Unsupported compiler: ${COMPILER_ID}" )
+endif()
+
+# Importer
+if( STAGE STREQUAL "importer" )
+    run( ${COMPILER} ${FLAGS} ${IMPORT_FLAGS} ${IMPORTER} print.o -o module_tests )
+    run( ./module_tests )
+endif()
@@ -0,0 +1,20 @@
+//====================================================
+//     Module
+//====================================================
+import ptc;
+
+//====================================================
+//     Main
+//====================================================
+int main()
+ {
+  // Printing through the module
+  ptc::print( "Testing", "the", "ptc", "module." );
+
+  // Checking the str mode
+  ptc::print.setSep( "*" );
+  const bool ok = ptc::print( ptc::mode::str, "a", 1, 2.5 ) == "a*1*2.5\n";
+  ptc::print.setSep( " " );
+
+  return ok ? 0 : 1;
+ }
@@ -0,0 +1,55 @@
+//====================================================
+//     Preprocessor directives
+//====================================================
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#define PTC_ENABLE_STATS
+
+//====================================================
+//     Headers
+//====================================================
+
+// My headers
+#include <include/ptc/print.hpp>
+
+// Extra headers
+#include <doctest/doctest.h>
+
+// STD headers
+#include <sstream>
+#include <thread>
+
+//====================================================
+//     Print stats
+//====================================================
+TEST_CASE( "Testing the Print stats method." )
+ {
+  ptc::Print<char> printer;
+  std::ostringstream ostr;
+  std::ostream& os = ostr;
+
+  // Single thread
+  printer( ostr, "Test", "\033[31mstats" );
+  printer.setFlush( true );
+  printer( ostr, 1, 2 );
+  printer.setFlush( false );
+  printer( os );
+
+  ptc::PrintStats stats = printer.stats();
+  CHECK_EQ( stats.calls, 3 );
+  CHECK_EQ( stats.bytes, ostr.str().size() );
+  CHECK_EQ( stats.flushes, 1 );
+  CHECK_EQ( stats.ansi_resets, 1 );
+  CHECK( stats.formatting.count() >= 0 );
+  CHECK( stats.writing.count() >= 0 );
+
+  // Counters of other threads are aggregated
+  std::thread other( [ &printer ](){ std::ostringstream other_ostr; printer( other_ostr, "Other", "thread" ); } );
+  other.join();
+  stats = printer.stats();
+  CHECK_EQ( stats.calls, 4 );
+  CHECK_EQ( stats.bytes, ostr.str().size() + 13 );
+
+  // Objects don't share counters
+  CHECK_EQ( ptc::Print<char>().stats().calls, 0 );
+ }
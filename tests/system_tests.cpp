@@ -110,7 +110,7 @@ void standard()
   std::wstring wstr_out = ptc::wprint( ptc::mode::str, "This", "is a wstring!\n" );
   std::wcout << wstr_out;
 
-  #if ! defined( PTC_ENABLE_PERFORMANCE_IMPROVEMENTS ) && ! defined( __APPLE__ )
+  #ifndef __APPLE__
 
   // Testing usage of print16
   std::basic_fstream<char16_t> file_stream_16( "test.txt", std::basic_ios<char16_t>::out | std::basic_ios<char16_t>::trunc );
@@ -124,6 +124,10 @@ void standard()
   file_stream_32.close();
   std::basic_string<char32_t> str32_out = ptc::print32( ptc::mode::str, "This", "is a wstring!\n" );
 
+  // Testing the UTF-8 output of print16 and print32
+  ptc::print16( u"Testing print16 to stdout:", u"\u00e8 \u20ac \U0001F600" );
+  ptc::print32( U"Testing print32 to stdout:", U"\u00e8 \u20ac \U0001F600" );
+
   #endif
  }
 
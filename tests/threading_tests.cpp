@@ -62,11 +62,19 @@ int main()
     ptc::print( "Testing", "this", "pattern", 123 );
     ptc::print.setPattern( "" );
 
+    ptc::print.setTimestamp( "%H:%M:%S.%3f" );
+    ptc::print.setThreadPrefix( true );
+    ptc::print.addPostWriteHook( []( const ptc::PrintEvent<char>& ){} );
+    ptc::print( "Testing", "the", "prefixes" );
+    ptc::print.clearHooks();
+    ptc::print.setThreadPrefix( false );
+    ptc::print.setTimestamp( "" );
+
     // Other ostream objects
     ptc::wprint();
     ptc::wprint( std::wcout, "Testing std::wcout!" );
 
-    #if ! defined( PTC_ENABLE_PERFORMANCE_IMPROVEMENTS ) && ! defined( __APPLE__ )
+    #ifndef __APPLE__
 
     std::basic_ostringstream<char16_t> oss16;
     ptc::print16( oss16, "Hello" );
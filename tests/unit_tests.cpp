@@ -11,7 +11,11 @@
 
 // My headers
 #include <include/ptc/print.hpp>
+#include <include/ptc/input.hpp>
 #include "utils.hpp"
+#if ! defined( _WIN32 )
+#include <include/ptc/shm_ring_sink.hpp>
+#endif
 
 // Extra headers
 #include <doctest/doctest.h>
@@ -23,6 +27,11 @@
 #include <string>
 #include <complex>
 #include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cctype>
+#include <iomanip>
+#include <memory>
 
 // Containers for testing
 #include <vector>
@@ -38,6 +47,10 @@
 #include <queue>
 #include <optional>
 #include <tuple>
+#ifdef PTC_HAS_RANGES
+#include <ranges>
+#include <span>
+#endif
 
 //====================================================
 //     Namespaces
@@ -180,7 +193,7 @@ TEST_CASE( "Testing the operator () overload." )
     file_stream_i.read( str, 26 );
     file_stream_i.close();
 
-    CHECK_EQ( static_cast<std::string> ( str ), "Test passes (ignore this)." );
+    CHECK_EQ( std::string( str, 26 ), "Test passes (ignore this)." );
    }
 
   // std::fstream case
@@ -197,7 +210,7 @@ TEST_CASE( "Testing the operator () overload." )
     file_stream_i.read( str, 26 );
     file_stream_i.close();
 
-    CHECK_EQ( static_cast<std::string> ( str ), "Test passes (ignore this)." );
+    CHECK_EQ( std::string( str, 26 ), "Test passes (ignore this)." );
    }
 
   // Passing variables inside ptc::print
@@ -267,7 +280,7 @@ TEST_CASE( "Testing case of other char types." )
     CHECK_EQ( wstr_in_2, wstr_out_2 );
    }
 
-  #if ! defined( PTC_ENABLE_PERFORMANCE_IMPROVEMENTS ) && ! defined( __APPLE__ )
+  #ifndef __APPLE__
 
   // char16_t
   SUBCASE( "Testing char16_t" )
@@ -279,6 +292,10 @@ TEST_CASE( "Testing case of other char types." )
     std::basic_string<char16_t> wstr_in_2 = ptc::print16( ptc::mode::str );
     std::basic_string<char16_t> wstr_out_2 = u"";
     CHECK_EQ( wstr_in_2, wstr_out_2 );
+
+    std::basic_string<char16_t> wstr_in_3 = ptc::print16( ptc::mode::str, u"Testing", u"this" );
+    std::basic_string<char16_t> wstr_out_3 = u"Testing this\n";
+    CHECK_EQ( wstr_in_3, wstr_out_3 );
    }
 
   // char32_t
@@ -291,6 +308,10 @@ TEST_CASE( "Testing case of other char types." )
     std::basic_string<char32_t> wstr_in_2 = ptc::print32( ptc::mode::str );
     std::basic_string<char32_t> wstr_out_2 = U"";
     CHECK_EQ( wstr_in_2, wstr_out_2 );
+
+    std::basic_string<char32_t> wstr_in_3 = ptc::print32( ptc::mode::str, U"Testing", U"this" );
+    std::basic_string<char32_t> wstr_out_3 = U"Testing this\n";
+    CHECK_EQ( wstr_in_3, wstr_out_3 );
    }
 
   // char8_t
@@ -310,6 +331,57 @@ TEST_CASE( "Testing case of other char types." )
   #endif
  }
 
+//====================================================
+//     UTF-8 output of other char types
+//====================================================
+#ifndef __APPLE__
+TEST_CASE( "Testing the UTF-8 output of the other char types." )
+ {
+  // Encoding
+  SUBCASE( "Testing Utf8Streambuf encoding." )
+   {
+    std::ostringstream bytes;
+    ptc::Utf8Streambuf<char16_t> buffer_16( bytes );
+    std::basic_ostream<char16_t> os_16( &buffer_16 );
+    ptc::print16( os_16, u"caf\u00e9", u"\u20ac", u"\U0001F600" );
+    CHECK_EQ( bytes.str(), "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\n" );
+
+    // Surrogate pair split between two writes and lone surrogates
+    bytes.str( "" );
+    const std::u16string smile = u"\U0001F600";
+    os_16.write( smile.data(), 1 );
+    os_16.write( smile.data() + 1, 1 );
+    os_16 << char16_t( 0xdc00 ) << char16_t( 0xd800 ) << u"a";
+    CHECK_EQ( bytes.str(), "\xf0\x9f\x98\x80\xef\xbf\xbd\xef\xbf\xbd" "a" );
+
+    bytes.str( "" );
+    ptc::Utf8Streambuf<char32_t> buffer_32( bytes );
+    std::basic_ostream<char32_t> os_32( &buffer_32 );
+    ptc::print32( os_32, std::u32string( 600, U'\u00e8' ), char32_t( 0x110000 ) );
+    CHECK_EQ( bytes.str().size(), 600 * 2 + 1 + 3 + 1 );
+    CHECK_EQ( bytes.str().substr( 1200 ), " \xef\xbf\xbd\n" );
+
+    bytes.str( "" );
+    ptc::Utf8Streambuf<wchar_t> buffer_w( bytes );
+    std::wostream os_w( &buffer_w );
+    ptc::wprint( os_w, L"\u00e8" );
+    CHECK_EQ( bytes.str(), "\xc3\xa8\n" );
+    CHECK_EQ( &buffer_w.sink(), &bytes );
+   }
+
+  // Default stream
+  SUBCASE( "Testing the default stream of print16." )
+   {
+    std::ostringstream bytes;
+    std::streambuf* previous = std::cout.rdbuf( bytes.rdbuf() );
+    ptc::print16( u"\u00e8", u"ok" );
+    ptc::print32( U"\U0001F600" );
+    std::cout.rdbuf( previous );
+    CHECK_EQ( bytes.str(), "\xc3\xa8 ok\n\xf0\x9f\x98\x80\n" );
+   }
+ }
+#endif
+
 //====================================================
 //     Print operator << overload
 //====================================================
@@ -542,6 +614,777 @@ TEST_CASE( "Testing the Print setFlush and getFlush methods." )
   ptc::print.setFlush( false );
  }
 
+//====================================================
+//     Print setFlushPolicy and getFlushPolicy
+//====================================================
+struct syncbuf: public std::stringbuf
+ {
+  int syncs = 0;
+  int sync() override { ++syncs; return std::stringbuf::sync(); }
+ };
+
+TEST_CASE( "Testing the Print setFlushPolicy and getFlushPolicy methods." )
+ {
+  ptc::Print<char> printer;
+  CHECK_EQ( printer.getFlushPolicy().lines, 0 );
+
+  // Lines policy
+  syncbuf buf;
+  std::ostream os( &buf );
+  printer.setFlushPolicy( { 3 } );
+  for( int i = 0; i < 7; ++i ) printer( os, "line", i );
+  CHECK_EQ( buf.syncs, 2 );
+  CHECK_EQ( printer.getFlushPolicy().lines, 3 );
+
+  // Bytes policy
+  syncbuf buf_bytes;
+  std::ostream os_bytes( &buf_bytes );
+  printer.setFlushPolicy( { 0, 12 } );
+  printer( os_bytes, "1234" );
+  printer( os_bytes, "1234" );
+  CHECK_EQ( buf_bytes.syncs, 0 );
+  printer( os_bytes, "1234" );
+  CHECK_EQ( buf_bytes.syncs, 1 );
+  CHECK_EQ( buf_bytes.str(), "1234\n1234\n1234\n" );
+
+  // Interval policy
+  syncbuf buf_time;
+  std::ostream os_time( &buf_time );
+  printer.setFlushPolicy( { 0, 0, std::chrono::milliseconds( 20 ) } );
+  printer( os_time, "first" );
+  CHECK_EQ( buf_time.syncs, 0 );
+  std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+  printer( os_time, "second" );
+  CHECK_EQ( buf_time.syncs, 1 );
+
+  // Error streams policy
+  ptc::FlushPolicy policy;
+  policy.on_error = true;
+  printer.setFlushPolicy( policy );
+  syncbuf buf_err;
+  std::streambuf* cerrbuf = std::cerr.rdbuf();
+  std::cerr.rdbuf( &buf_err );
+  std::cerr.unsetf( std::ios_base::unitbuf );
+  printer( std::cerr, "error" );
+  std::cerr.setf( std::ios_base::unitbuf );
+  std::cerr.rdbuf( cerrbuf );
+  CHECK_EQ( buf_err.syncs, 1 );
+  syncbuf buf_out;
+  std::ostream os_out( &buf_out );
+  printer( os_out, "not an error" );
+  CHECK_EQ( buf_out.syncs, 0 );
+
+  // setFlush still flushes every line
+  printer.setFlushPolicy( {} );
+  printer.setFlush( true );
+  printer( os_out, "flushed" );
+  printer( os_out );
+  CHECK_EQ( buf_out.syncs, 2 );
+ }
+
+//====================================================
+//     Print setTTY
+//====================================================
+TEST_CASE( "Testing the Print setTTY and getTTY methods." )
+ {
+  ptc::Print<char> printer;
+  CHECK( printer.getTTY() == ptc::tty::automatic );
+
+  // Escape sequences stripping
+  std::string text = "\033[31mred\033[0m \033]8;;http://x\033\\link\033]8;;\a \0337end\033[";
+  text.resize( ptc::strip_escapes( text.data(), text.size() ) );
+  CHECK_EQ( text, "red link end" );
+
+  // String streams are left untouched
+  std::ostringstream ostr;
+  printer( ostr, "\033[31mred", "line" );
+  CHECK_EQ( ostr.str(), "\033[31mred line\n\033[0m" );
+
+  // Forced behavior
+  ostr.str( "" );
+  printer.setTTY( ptc::tty::never );
+  printer.setPattern( "\033[1m" );
+  printer( ostr, "\033[31mred", "line" );
+  printer.setPattern( "" );
+  printer.table( ostr, std::vector<std::vector<std::string>>{ { "\033[32mok", "x" } } );
+  CHECK_EQ( ostr.str(), "red line\nok x\n" );
+  CHECK_EQ( printer( ptc::mode::str, "\033[31mred" ), "\033[31mred\n\033[0m" );
+  CHECK( printer.getTTY() == ptc::tty::never );
+
+  // Requested flushes apply also to streams which are not terminals
+  syncbuf buf;
+  std::ostream os( &buf );
+  printer( os, "line" );
+  CHECK_EQ( buf.syncs, 0 );
+  printer.setFlush( true );
+  printer( os, "line" );
+  CHECK_EQ( buf.syncs, 1 );
+  printer.setFlush( false );
+  printer.setFlushPolicy( { 1 } );
+  printer( os, "line" );
+  CHECK_EQ( buf.syncs, 2 );
+  printer.setFlushPolicy( {} );
+
+  // File streams are not terminals
+  printer.setTTY( ptc::tty::automatic );
+  const ptc::TempFile tty_file( "ptc_tty_test.txt" );
+  std::string line;
+   {
+    std::ofstream file( tty_file.path, std::ios::trunc );
+    printer.setFlush( true );
+    printer( file, "\033[31mred", "file" );
+    printer.setFlush( false );
+    std::ifstream flushed( tty_file.path );
+    std::getline( flushed, line );
+    CHECK_EQ( line, "red file" );
+   }
+ }
+
+//====================================================
+//     Print setTimestamp
+//====================================================
+TEST_CASE( "Testing the Print setTimestamp method." )
+ {
+  ptc::Print<char> printer;
+  std::ostringstream ostr;
+  std::ostream& os = ostr;
+
+  // Date and sub-second digits
+  printer.setTimestamp( "[%Y-%m-%d %H:%M:%S.%3f]", ptc::time_zone::utc );
+  printer( os, "Test", "passes" );
+  const std::string line = ostr.str();
+  REQUIRE_EQ( line.size(), std::string( "[2022-07-14 12:00:00.000] Test passes\n" ).size() );
+  CHECK_EQ( line.front(), '[' );
+  CHECK_EQ( line[20], '.' );
+  CHECK_EQ( line.substr( 25 ), " Test passes\n" );
+  for( std::size_t i: { 1, 2, 3, 4, 21, 22, 23 } ) CHECK( std::isdigit( line[i] ) );
+
+  // Cached rendering across calls and threads
+  ostr.str( "" );
+  printer( os, 1 );
+  printer( os, 2 );
+  std::thread( [ & ]{ printer( os, 3 ); } ).join();
+  std::istringstream lines( ostr.str() );
+  std::string first_line, second_line, third_line;
+  std::getline( lines, first_line );
+  std::getline( lines, second_line );
+  std::getline( lines, third_line );
+  CHECK_EQ( first_line.substr( 0, 5 ), second_line.substr( 0, 5 ) );
+  CHECK_EQ( first_line.back(), '1' );
+  CHECK_EQ( third_line.back(), '3' );
+  CHECK_EQ( third_line.size(), first_line.size() );
+
+  // Default microseconds, literal "%%f" and sep
+  ostr.str( "" );
+  printer.setSep( "|" );
+  printer.setTimestamp( "%f%%f" );
+  printer( os, "x" );
+  CHECK_EQ( ostr.str().size(), 11 );
+  CHECK_EQ( ostr.str().substr( 6 ), "%f|x\n" );
+
+  // Strings are never prefixed
+  CHECK_EQ( printer( ptc::mode::str, "a", "b" ), "a|b\n" );
+
+  // Disabling
+  ostr.str( "" );
+  printer.setTimestamp( "" );
+  printer( os, "x" );
+  CHECK_EQ( ostr.str(), "x\n" );
+
+  // Wide strings
+  ptc::Print<wchar_t> wprinter;
+  std::wostringstream wostr;
+  std::wostream& wos = wostr;
+  wprinter.setTimestamp( "%Y", ptc::time_zone::local );
+  wprinter( wos, std::wstring( L"wide" ) );
+  CHECK_EQ( wostr.str().size(), 10 );
+  CHECK_EQ( wostr.str().substr( 4 ), L" wide\n" );
+ }
+
+//====================================================
+//     Print setThreadPrefix and getThreadPrefix
+//====================================================
+TEST_CASE( "Testing the Print setThreadPrefix and getThreadPrefix methods." )
+ {
+  ptc::Print<char> printer;
+  CHECK_EQ( printer.getThreadPrefix(), false );
+  printer.setThreadPrefix( true );
+  CHECK_EQ( printer.getThreadPrefix(), true );
+
+  std::ostringstream ostr;
+  std::ostream& os = ostr;
+
+  // Thread id
+  std::ostringstream id;
+  id << std::this_thread::get_id();
+  printer( os, "Test" );
+  CHECK_EQ( ostr.str(), id.str() + " Test\n" );
+
+  // Thread name
+  ostr.str( "" );
+  ptc::set_thread_name( "[main]" );
+  printer( os, "Test" );
+  CHECK_EQ( ostr.str(), "[main] Test\n" );
+  CHECK_EQ( printer( ptc::mode::str, "Test" ), "Test\n" );
+
+  // Other threads keep their own name
+  ostr.str( "" );
+  std::thread( [ & ]{ ptc::set_thread_name( "worker" ); printer( os, "Test" ); } ).join();
+  CHECK_EQ( ostr.str(), "worker Test\n" );
+
+  // Wide strings
+  ptc::Print<wchar_t> wprinter;
+  wprinter.setThreadPrefix( true );
+  std::wostringstream wostr;
+  std::wostream& wos = wostr;
+  wprinter( wos, std::wstring( L"Test" ) );
+  CHECK( wostr.str() == L"[main] Test\n" );
+
+  ptc::set_thread_name( "" );
+ }
+
+//====================================================
+//     Print setDeduplication and getDeduplication
+//====================================================
+TEST_CASE( "Testing the Print setDeduplication and getDeduplication methods." )
+ {
+  ptc::Print<char> printer;
+  CHECK_EQ( printer.getDeduplication().count(), 0 );
+  printer.setDeduplication( std::chrono::hours( 1 ) );
+  CHECK_EQ( printer.getDeduplication(), std::chrono::hours( 1 ) );
+
+  std::ostringstream ostr;
+  std::streambuf* coutbuf = std::cout.rdbuf( ostr.rdbuf() );
+  std::ostream& os = std::cout;
+
+  // Consecutive duplicates
+  for( int i = 0; i < 5; ++i ) printer( os, "Error:", 42 );
+  printer( os, "Other" );
+  printer( os, "Other" );
+  printer( os, "Error:", 42 );
+  CHECK_EQ( ostr.str(), "Error: 42\nlast message repeated 4 times\nOther\nlast message repeated 1 time\nError: 42\n" );
+
+  // Prefixes are excluded from the comparison
+  ostr.str( "" );
+  printer.setThreadPrefix( true );
+  printer( os, "Error:", 42 );
+  printer( os, "Error:", 42 );
+  CHECK_EQ( ostr.str(), "" );
+  printer.setThreadPrefix( false );
+
+  // Strings and other streams are never suppressed
+  CHECK_EQ( printer( ptc::mode::str, "Error:", 42 ), "Error: 42\n" );
+  std::ostringstream other;
+  printer( other, "Error:", 42 );
+  printer( other, "Error:", 42 );
+  CHECK_EQ( other.str(), "Error: 42\nError: 42\n" );
+  CHECK_EQ( ostr.str(), "" );
+  printer( os, "Other" );
+  CHECK_EQ( ostr.str(), "last message repeated 2 times\nOther\n" );
+
+  // A destroyed stream is never reported to
+  auto temporary = std::make_unique<std::ostringstream>();
+  printer( *temporary, "same" );
+  printer( *temporary, "same" );
+  CHECK_EQ( temporary -> str(), "same\nsame\n" );
+  temporary.reset();
+  ostr.str( "" );
+  printer( os, "different" );
+  CHECK_EQ( ostr.str(), "different\n" );
+
+  // Expired window and pending report
+  ostr.str( "" );
+  printer.setDeduplication( std::chrono::milliseconds( 0 ) );
+  CHECK_EQ( ostr.str(), "" );
+  printer.setDeduplication( std::chrono::milliseconds( 20 ) );
+  printer( os, "Test" );
+  printer( os, "Test" );
+  std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+  printer( os, "Test" );
+  printer( os, "Test" );
+  printer.setDeduplication( std::chrono::milliseconds( 0 ) );
+  printer( os, "Test" );
+  CHECK_EQ( ostr.str(), "Test\nlast message repeated 1 time\nTest\nlast message repeated 1 time\nTest\n" );
+  std::cout.rdbuf( coutbuf );
+ }
+
+//====================================================
+//     Sampled printing
+//====================================================
+TEST_CASE( "Testing the sampled printing macros." )
+ {
+  std::ostringstream ostr;
+  std::ostream& os = ostr;
+
+  // Every n
+  int evaluated = 0;
+  for( int i = 0; i < 10; ++i ) PTC_PRINT_EVERY_N( 4, os, i, ++evaluated );
+  CHECK_EQ( ostr.str(), "0 1\n4 2\n8 3\n" );
+  CHECK_EQ( evaluated, 3 );
+
+  // First n
+  ostr.str( "" );
+  for( int i = 0; i < 10; ++i ) PTC_PRINT_FIRST_N( 2, os, i );
+  CHECK_EQ( ostr.str(), "0\n1\n" );
+
+  // Rate
+  ostr.str( "" );
+  for( int i = 0; i < 10; ++i ) PTC_PRINT_RATE( 2, os, i );
+  CHECK_EQ( ostr.str(), "0\n1\n" );
+  ostr.str( "" );
+  for( int i = 0; i < 10; ++i ) PTC_PRINT_RATE( 0.5, os, i );
+  CHECK_EQ( ostr.str(), "0\n" );
+
+  // Concurrent call sites
+  ptc::EveryN every_n;
+  ptc::FirstN first_n;
+  ptc::RateLimit rate;
+  std::atomic<int> every_passed{ 0 }, first_passed{ 0 }, rate_passed{ 0 };
+  std::vector<std::thread> threads;
+  for( int t = 0; t < 4; ++t )
+   {
+    threads.emplace_back( [ & ]
+     {
+      for( int i = 0; i < 1000; ++i )
+       {
+        if ( every_n.pass( 10 ) ) ++every_passed;
+        if ( first_n.pass( 5 ) ) ++first_passed;
+        if ( rate.pass( 3 ) ) ++rate_passed;
+       }
+     } );
+   }
+  for( auto& thread: threads ) thread.join();
+  CHECK_EQ( every_passed, 400 );
+  CHECK_EQ( first_passed, 5 );
+  CHECK( rate_passed >= 3 );
+  CHECK( rate_passed <= 4 );
+ }
+
+//====================================================
+//     Print tables
+//====================================================
+TEST_CASE( "Testing the Print table and tableRow methods." )
+ {
+  ptc::Print<char> printer;
+  std::ostringstream ostr;
+  std::ostream& os = ostr;
+
+  // Tuple rows with headers
+  const std::vector<std::tuple<std::string, int, double>> rows = { { "alpha", 1, 2.5 }, { "beta", 12345, 0.125 } };
+  printer.table( os, rows, { "name", "count", "ratio" } );
+  CHECK_EQ( ostr.str(), "name  count ratio\n"
+                        "----- ----- -----\n"
+                        "alpha     1   2.5\n"
+                        "beta  12345 0.125\n" );
+
+  // Range rows, separator and UTF-8 and ANSI widths
+  ostr.str( "" );
+  printer.setSep( " | " );
+  const std::vector<std::vector<std::string>> words = { { "\033[31mred\033[0m", "x" }, { "città", "yy" } };
+  printer.table( os, words );
+  CHECK_EQ( ostr.str(), "\033[31mred\033[0m   | x\n"
+                        "città | yy\n\033[0m" );
+  printer.setSep( " " );
+
+  // Stream settings
+  ostr.str( "" );
+  ostr << std::fixed << std::setprecision( 1 );
+  printer.table( os, std::vector<std::array<double, 2>>{ { 1.25, 10 } } );
+  CHECK_EQ( ostr.str(), "1.2 10.0\n" );
+  ostr << std::defaultfloat << std::setprecision( 6 );
+
+  // Streamed rows
+  ostr.str( "" );
+  printer.tableRow( os, { 4, 3 }, std::make_tuple( "id", "n" ), true );
+  printer.tableRow( os, { 4, 3 }, std::make_tuple( 7, 42 ) );
+  printer.tableRow( os, { 4, 3 }, std::make_tuple( "overflow", 1 ) );
+  CHECK_EQ( ostr.str(), "id   n\n"
+                        "---- ---\n"
+                        "   7  42\n"
+                        "overflow   1\n" );
+
+  // ptc::print_table and ptc::TableWriter
+  ostr.str( "" );
+  ptc::print_table( std::vector<std::pair<std::string, int>>{ { "a", 1 }, { "bb", 22 } }, {}, os );
+  ptc::TableWriter writer( { 3, 2 }, os );
+  writer.header( "k", "v" );
+  writer( "c", 3 );
+  CHECK_EQ( ostr.str(), "a   1\n"
+                        "bb 22\n"
+                        "k   v\n"
+                        "--- --\n"
+                        "c    3\n" );
+ }
+
+//====================================================
+//     Nested ranges
+//====================================================
+TEST_CASE( "Testing the ptc::nested function." )
+ {
+  std::ostringstream ostr;
+
+  // Same output of the containers overloads
+  const std::vector<std::vector<double>> matrix = { { 1, 2.5, 3 }, { -10, 200, 0.125 } };
+  const std::list<std::vector<std::string>> words = { { "a", "bb" }, {} };
+  const int array[2][2] = { { 1, 2 }, { 3, 4 } };
+  ostr << ptc::nested( matrix ) << ' ' << ptc::nested( words ) << ' ' << ptc::nested( array ) << ' ' << ptc::nested( std::vector<int>{} ) << '\n';
+  CHECK_EQ( ostr.str(), ptc::print( ptc::mode::str, matrix, words, "[[1, 2], [3, 4]]", "[]" ) );
+  CHECK_EQ( ptc::print( ptc::mode::str, "m:", ptc::nested( matrix ) ), "m: [[1, 2.5, 3], [-10, 200, 0.125]]\n" );
+
+  // Stream settings
+  ostr.str( "" );
+  ostr << std::fixed << std::setprecision( 2 ) << ptc::nested( matrix ) << std::defaultfloat << std::setprecision( 6 );
+  ostr << std::hex << ptc::nested( std::vector<int>{ -1, 255 } ) << std::dec;
+  ostr << std::showpos << ptc::nested( std::vector<int>{ 1, -1 } ) << std::noshowpos;
+  CHECK_EQ( ostr.str(), "[[1.00, 2.50, 3.00], [-10.00, 200.00, 0.12]][ffffffff, ff][+1, -1]" );
+
+  // Aligned layout
+  ostr.str( "" );
+  ostr << ptc::nested( matrix, ptc::layout::aligned );
+  CHECK_EQ( ostr.str(), "[[    1,   2.5,     3],\n"
+                        " [  -10,   200, 0.125]]" );
+  ostr.str( "" );
+  const std::vector<std::vector<std::vector<int>>> cube = { { { 1, 2 }, { 3, 4 } }, { { 5, 66 } } };
+  ostr << ptc::nested( cube, ptc::layout::aligned );
+  CHECK_EQ( ostr.str(), "[[[ 1,  2],\n"
+                        "  [ 3,  4]],\n"
+                        " [[ 5, 66]]]" );
+
+  // Temporaries are stored
+  ostr.str( "" );
+  const auto stored = ptc::nested( std::vector<std::vector<int>>{ { 1, 2 }, { 3 } } );
+  ostr << stored;
+  CHECK_EQ( ostr.str(), "[[1, 2], [3]]" );
+
+  // Wide streams
+  std::wostringstream wostr;
+  wostr << ptc::nested( matrix );
+  CHECK( wostr.str() == L"[[1, 2.5, 3], [-10, 200, 0.125]]" );
+ }
+
+//====================================================
+//     Ranges printing
+//====================================================
+#ifdef PTC_HAS_RANGES
+TEST_CASE( "Testing the ranges views printing and ptc::limit." )
+ {
+  std::vector<int> values = { 1, 2, 3, 4, 5, 6 };
+  const std::vector<std::string> words = { "a", "bb" };
+
+  // Contiguous views and lazy views
+  CHECK_EQ( ptc::print( ptc::mode::str, std::span<const int>( values ), std::span<const std::string>( words ), std::span<int>( values.data(), 0 ) ), "[1, 2, 3, 4, 5, 6] [a, bb] []\n" );
+  auto even = values | std::views::filter( []( int x ){ return x % 2 == 0; } );
+  CHECK_EQ( ptc::print( ptc::mode::str, even, values | std::views::transform( []( int x ){ return x * 10; } ) | std::views::take( 2 ) ), "[2, 4, 6] [10, 20]\n" );
+  std::vector<std::span<const int>> halves = { std::span<const int>( values ).first( 3 ), std::span<const int>( values ).last( 3 ) };
+  CHECK_EQ( ptc::print( ptc::mode::str, halves ), "[[1, 2, 3], [4, 5, 6]]\n" );
+  CHECK_EQ( ptc::print( ptc::mode::str, std::string_view( "text" ) ), "text\n" );
+
+  // Limits
+  CHECK_EQ( ptc::print( ptc::mode::str, ptc::limit( std::views::iota( 0 ), 3 ) ), "[0, 1, 2, ...]\n" );
+  CHECK_EQ( ptc::print( ptc::mode::str, ptc::limit( values, 2 ), ptc::limit( values, 6 ), ptc::limit( values, 0 ) ), "[1, 2, ...] [1, 2, 3, 4, 5, 6] [...]\n" );
+  const auto limited = ptc::limit( std::views::iota( 1 ) | std::views::filter( []( int x ){ return x % 3 == 0; } ), 2 );
+  CHECK_EQ( ptc::print( ptc::mode::str, limited ), "[3, 6, ...]\n" );
+
+  // Wide streams
+  CHECK( ptc::wprint( ptc::mode::str, std::span<const int>( values ).first( 2 ), ptc::limit( even, 1 ) ) == L"[1, 2] [2, ...]\n" );
+ }
+#endif
+
+//====================================================
+//     Numbers formatting
+//====================================================
+TEST_CASE( "Testing the numeric format adapters." )
+ {
+  std::ostringstream ostr;
+  ostr << std::setprecision( 3 ) << std::showpos;
+
+  // Formats
+  ostr << ptc::hex( 255 ) << ' ' << ptc::hex( -1 ) << ' ' << ptc::hex( std::uint64_t( 0xdeadbeefcafe ) ) << ' ' << ptc::bin( 5 ) << ' ' << ptc::bin( std::int8_t( -2 ) ) << ' ' << ptc::bin( 0u );
+  CHECK_EQ( ostr.str(), "ff ffffffff deadbeefcafe 101 11111110 0" );
+  ostr.str( "" );
+  ostr << ptc::fixed( 3.14159, 2 ) << ' ' << ptc::fixed( 2 ) << ' ' << ptc::sci( 1500.0, 2 ) << ' ' << ptc::sci( -0.5f, 1 );
+  CHECK_EQ( ostr.str(), "3.14 2.000000 1.50e+03 -5.0e-01" );
+
+  // Padding
+  ostr.str( "" );
+  ostr << ptc::pad( ptc::hex( 255 ), 4, '0' ) << '|' << ptc::pad( 42, 5 ) << '|' << ptc::pad( -7, 4, '0' ) << '|' << ptc::pad( "ab", 4, '.' ) << '|' << ptc::pad( 12345, 2 ) << '|' << ptc::pad( 2.5, 5 );
+  CHECK_EQ( ostr.str(), "00ff|   42|-007|..ab|12345|  2.5" );
+
+  // The stream settings are not used nor modified
+  CHECK_EQ( ostr.precision(), 3 );
+  CHECK( ( ostr.flags() & std::ios_base::showpos ) );
+  CHECK_EQ( ostr.flags() & std::ios_base::basefield, std::ios_base::dec );
+
+  // Very long numbers
+  ostr.str( "" );
+  ostr << ptc::fixed( 1e300, 1 );
+  CHECK_EQ( ostr.str().size(), 303 );
+  CHECK_EQ( ostr.str().substr( 0, 2 ), "10" );
+
+  // Other char types and print
+  std::wostringstream wostr;
+  wostr << ptc::pad( ptc::bin( 3 ), 4, '0' );
+  CHECK( wostr.str() == L"0011" );
+  CHECK_EQ( ptc::print( ptc::mode::str, ptc::hex( 10 ), ptc::fixed( 1.0, 1 ) ), "a 1.0\n" );
+ }
+
+//====================================================
+//     Pointers information
+//====================================================
+TEST_CASE( "Testing the ptc::ptr function." )
+ {
+  int value = 2;
+  int* pointer = &value;
+  int** pointer_2 = &pointer;
+  std::ostringstream expected;
+  expected << "Value: 0x" << std::hex << reinterpret_cast<std::uintptr_t>( pointer ) << "\nAddress: 0x" << reinterpret_cast<std::uintptr_t>( &pointer );
+
+  // Fixed buffer and conversions
+  const auto info = ptc::ptr( pointer );
+  CHECK_EQ( info.str(), expected.str() );
+  CHECK_EQ( std::string( info ), expected.str() );
+  CHECK_EQ( ptc::print( ptc::mode::str, ptc::ptr( pointer ) ), expected.str() + "\n" );
+
+  // Higher-order pointers
+  std::ostringstream expected_2;
+  expected_2 << "Value: 0x" << std::hex << reinterpret_cast<std::uintptr_t>( pointer_2 ) << "\nAddress: 0x" << reinterpret_cast<std::uintptr_t>( &pointer_2 );
+  CHECK_EQ( ptc::ptr( pointer_2 ).str(), expected_2.str() );
+
+  // Null pointer
+  int* null = nullptr;
+  CHECK_EQ( ptc::ptr( null ).view().substr( 0, 11 ), "Value: 0x0\n" );
+
+  // Stream and output iterator overloads
+  std::ostringstream ostr;
+  ptc::ptr( ostr, pointer ) << '!';
+  CHECK_EQ( ostr.str(), expected.str() + "!" );
+  std::string out;
+  ptc::ptr( std::back_inserter( out ), pointer );
+  CHECK_EQ( out, expected.str() );
+
+  // Other char types
+  std::wostringstream wostr;
+  ptc::ptr( wostr, pointer );
+  const std::string narrow = expected.str();
+  CHECK( wostr.str() == std::wstring( narrow.begin(), narrow.end() ) );
+  CHECK( ptc::ptr<wchar_t>( pointer ).str() == wostr.str() );
+ }
+
+//====================================================
+//     Bytes printing
+//====================================================
+TEST_CASE( "Testing the ptc::hex_bytes and ptc::hexdump functions." )
+ {
+  std::ostringstream ostr;
+  std::vector<unsigned char> bytes( 40 );
+  for( std::size_t i = 0; i < bytes.size(); ++i ) bytes[ i ] = static_cast<unsigned char>( i * 7 + 0x20 );
+  std::ostringstream expected;
+  for( unsigned char byte: bytes ) expected << std::hex << std::setw( 2 ) << std::setfill( '0' ) << static_cast<int>( byte );
+
+  // hex_bytes
+  ostr << ptc::hex_bytes( bytes );
+  CHECK_EQ( ostr.str(), expected.str() );
+  ostr.str( "" );
+  const std::array<std::uint8_t, 4> packet = { 0xde, 0xad, 0xbe, 0xef };
+  ostr << ptc::hex_bytes( packet, " " ) << '|' << ptc::hex_bytes( packet.data(), 2, ":" ) << '|' << ptc::hex_bytes( packet.data(), 0 );
+  CHECK_EQ( ostr.str(), "de ad be ef|de:ad|" );
+  CHECK_EQ( ptc::print( ptc::mode::str, ptc::hex_bytes( std::string( "AZ" ) ) ), "415a\n" );
+  const auto separated = ptc::hex_bytes( packet, std::string( " - " ) );
+  ostr.str( "" );
+  ostr << separated;
+  CHECK_EQ( ostr.str(), "de - ad - be - ef" );
+
+  // hexdump
+  ostr.str( "" );
+  const char raw[] = "Hello, world!\n\x00\x01" "abc";
+  const std::string text( raw, sizeof( raw ) - 1 );
+  ostr << ptc::hexdump( text );
+  CHECK_EQ( ostr.str(), "00000000  48 65 6c 6c 6f 2c 20 77  6f 72 6c 64 21 0a 00 01  |Hello, world!...|\n"
+                        "00000010  61 62 63                                          |abc|" );
+  ostr.str( "" );
+  ostr << ptc::hexdump( text.data(), 0 );
+  CHECK_EQ( ostr.str(), "" );
+
+  // Wide streams
+  std::wostringstream wostr;
+  wostr << ptc::hex_bytes( packet, ", " );
+  CHECK( wostr.str() == L"de, ad, be, ef" );
+ }
+
+//====================================================
+//     Print literal lines
+//====================================================
+#ifdef PTC_HAS_LITERAL_LINES
+TEST_CASE( "Testing the ptc::print_lit function." )
+ {
+  // Compile-time lines
+  constexpr auto line = ptc::literal_line<"Starting", "server", "!">();
+  CHECK_EQ( std::string( line.data, line.size ), "Starting server !\n" );
+  constexpr auto ansi_line = ptc::literal_line<"\033[31m", "red", "line">();
+  CHECK_EQ( std::string( ansi_line.data, ansi_line.size ), ptc::print( ptc::mode::str, "\033[31m", "red", "line" ) );
+  constexpr auto single_line = ptc::literal_line<"single">();
+  CHECK_EQ( std::string( single_line.data, single_line.size ), "single\n" );
+
+  // Printing
+  std::ostringstream ostr;
+  ptc::print_lit<"Starting", "server", "!">( ostr );
+  CHECK_EQ( ostr.str(), "Starting server !\n" );
+
+  ostr.str( "" );
+  ptc::Print<char> printer;
+  printer.literal<"Starting", "server">( ostr );
+  CHECK_EQ( ostr.str(), "Starting server\n" );
+
+  // Runtime fallback
+  ostr.str( "" );
+  printer.setSep( "*" );
+  printer.literal<"Starting", "server">( ostr );
+  CHECK_EQ( ostr.str(), "Starting*server\n" );
+ }
+#endif
+
+//====================================================
+//     Print setAsync
+//====================================================
+struct gatebuf: public std::stringbuf
+ {
+  std::atomic<bool> open{ true }, entered{ false };
+  std::streamsize xsputn( const char* s, std::streamsize n ) override
+   {
+    entered = true;
+    while( ! open ) std::this_thread::yield();
+    return std::stringbuf::xsputn( s, n );
+   }
+ };
+
+TEST_CASE( "Testing the Print setAsync method." )
+ {
+  std::streambuf* coutbuf = std::cout.rdbuf();
+  ptc::AsyncPolicy policy;
+  policy.capacity = 4;
+
+  // Blocking until the lines fit
+   {
+    gatebuf buf;
+    std::cout.rdbuf( &buf );
+    ptc::Print<char> printer;
+    printer.setAsync( policy );
+    for( int i = 0; i < 50; ++i ) printer( "Line", i );
+    printer();
+    printer.drainAsync();
+    std::string expected;
+    for( int i = 0; i < 50; ++i ) expected += "Line " + std::to_string( i ) + "\n";
+    CHECK_EQ( buf.str(), expected + "\n" );
+    CHECK_EQ( printer.asyncStats().written, 51 );
+    CHECK_EQ( printer.asyncStats().dropped, 0 );
+    printer.setAsync( {} );
+   }
+
+  // Dropping the new lines, with summary
+   {
+    gatebuf buf;
+    std::cout.rdbuf( &buf );
+    ptc::Print<char> printer;
+    policy.on_overflow = ptc::overflow::drop_newest;
+    printer.setAsync( policy );
+    buf.open = false;
+    printer( "First" );
+    while( ! buf.entered ) std::this_thread::yield();
+    for( int i = 0; i < 10; ++i ) printer( "Line", i );
+    buf.open = true;
+    printer.drainAsync();
+    CHECK_EQ( printer.asyncStats().dropped, 6 );
+    printer( "Last" );
+    printer.setAsync( {} );
+    CHECK_EQ( buf.str(), "First\nLine 0\nLine 1\nLine 2\nLine 3\nptc: 6 lines dropped\nLast\n" );
+   }
+
+  // Overwriting the oldest lines
+   {
+    gatebuf buf;
+    std::cout.rdbuf( &buf );
+    ptc::Print<char> printer;
+    policy.on_overflow = ptc::overflow::overwrite_oldest;
+    policy.summary = false;
+    printer.setAsync( policy );
+    buf.open = false;
+    printer( "First" );
+    while( ! buf.entered ) std::this_thread::yield();
+    for( int i = 0; i < 10; ++i ) printer( "Line", i );
+    buf.open = true;
+    printer.setAsync( {} );
+    CHECK_EQ( buf.str(), "First\nLine 6\nLine 7\nLine 8\nLine 9\n" );
+   }
+
+  // Overwritten lines are all reported
+   {
+    gatebuf buf;
+    std::cout.rdbuf( &buf );
+    ptc::Print<char> printer;
+    ptc::AsyncPolicy lossy;
+    lossy.capacity = 2;
+    lossy.on_overflow = ptc::overflow::overwrite_oldest;
+    printer.setAsync( lossy );
+    buf.open = false;
+    printer( "First" );
+    while( ! buf.entered ) std::this_thread::yield();
+    for( int i = 0; i < 200; ++i ) printer( "Line", i );
+    buf.open = true;
+    CHECK_EQ( printer.asyncStats().overwritten, 198 );
+    printer.setAsync( {} );
+    std::istringstream output( buf.str() );
+    std::string line;
+    std::uint64_t printed = 0, reported = 0;
+    while( std::getline( output, line ) )
+     {
+      if ( line.rfind( "ptc: ", 0 ) == 0 ) reported += std::stoull( line.substr( 5 ) );
+      else ++printed;
+     }
+    CHECK_EQ( printed, 3 );
+    CHECK_EQ( reported, 198 );
+    CHECK_EQ( printed + reported, 201 );
+   }
+
+  // Spilling to a file
+   {
+    const ptc::TempFile spill_file( "ptc_spill.txt" );
+    gatebuf buf;
+    std::cout.rdbuf( &buf );
+    ptc::Print<char> printer;
+    policy.on_overflow = ptc::overflow::spill;
+    policy.spill_path = spill_file.path;
+    printer.setAsync( policy );
+    buf.open = false;
+    printer( "First" );
+    while( ! buf.entered ) std::this_thread::yield();
+    for( int i = 0; i < 6; ++i ) printer( "Line", i );
+    buf.open = true;
+    printer.drainAsync();
+    CHECK_EQ( printer.asyncStats().spilled, 2 );
+    printer.setAsync( {} );
+    std::ifstream spill( spill_file.path );
+    std::stringstream content;
+    content << spill.rdbuf();
+    CHECK_EQ( content.str(), "Line 4\nLine 5\n" );
+    spill.close();
+    CHECK_EQ( buf.str(), "First\nLine 0\nLine 1\nLine 2\nLine 3\n" );
+    policy.on_overflow = ptc::overflow::block;
+   }
+
+  // Other streams are written directly
+   {
+    ptc::Print<char> printer;
+    printer.setAsync( policy );
+    std::ostringstream ostr;
+    std::ostream& os = ostr;
+    printer( os, "Direct" );
+    CHECK_EQ( ostr.str(), "Direct\n" );
+    CHECK_EQ( printer.asyncStats().queued, 0 );
+   }
+
+  std::cout.rdbuf( coutbuf );
+ }
+
 //====================================================
 //     Print setPattern and getPattern
 //====================================================
@@ -562,4 +1405,271 @@ TEST_CASE( "Testing the Print setPattern and getPattern methods." )
   CHECK_EQ( ptc::print( ptc::mode::str, "Testing", "this", "pattern" ), "Testing this pattern" );
 
   ptc::print.setEnd( "\n" );
- }
\ No newline at end of file
+ }
+//====================================================
+//     Print hooks
+//====================================================
+TEST_CASE( "Testing the Print hooks methods." )
+ {
+  // Pre-write and post-write hooks
+  SUBCASE( "Testing pre-write and post-write hooks." )
+   {
+    ptc::Print<char> printer;
+    std::ostringstream ostr;
+    std::vector<ptc::PrintEvent<char>> pre_events, post_events;
+    printer.addPreWriteHook( [ &pre_events ]( const ptc::PrintEvent<char>& event ){ pre_events.push_back( event ); } );
+    printer.addPostWriteHook( [ &post_events ]( const ptc::PrintEvent<char>& event ){ post_events.push_back( event ); } );
+
+    printer( ostr, "Testing", "hooks" );
+    CHECK_EQ( ostr.str(), "Testing hooks\n" );
+    CHECK_EQ( pre_events.size(), 1 );
+    CHECK_EQ( post_events.size(), 1 );
+    CHECK_EQ( pre_events[0].stream, &ostr );
+    CHECK_EQ( pre_events[0].bytes, 14 );
+    CHECK_EQ( pre_events[0].writing.count(), 0 );
+    CHECK_EQ( post_events[0].bytes, 14 );
+    CHECK_EQ( post_events[0].start, pre_events[0].start );
+    CHECK( post_events[0].writing.count() >= 0 );
+
+    printer.clearHooks();
+    printer( ostr, "No", "hooks" );
+    CHECK_EQ( post_events.size(), 1 );
+   }
+
+  // Chrome trace hook
+  SUBCASE( "Testing the ChromeTrace hook." )
+   {
+    const ptc::TempFile trace_file( "ptc_trace.json" );
+     {
+      ptc::Print<char> printer;
+      std::ostringstream ostr;
+      printer.addPostWriteHook( ptc::ChromeTrace( trace_file.path ) );
+      printer( ostr, "Tracing", "this" );
+      printer( ostr, "Tracing", "that" );
+     }
+
+    std::ifstream file_stream_i( trace_file.path );
+    std::stringstream trace;
+    trace << file_stream_i.rdbuf();
+    const std::string json = trace.str();
+    CHECK_EQ( json.front(), '[' );
+    CHECK_EQ( json.substr( json.size() - 2 ), "]\n" );
+    CHECK( json.find( R"("name":"ptc::print")" ) != std::string::npos );
+    CHECK( json.find( R"("name":"write")" ) != std::string::npos );
+    CHECK( json.find( R"("ph":"X")" ) != std::string::npos );
+    CHECK( json.find( R"("bytes":13,"stream":"stream")" ) != std::string::npos );
+    CHECK_THROWS_AS( ptc::ChromeTrace( trace_file.path + "/missing/trace.json" ), std::runtime_error );
+   }
+ }
+
+//====================================================
+//     FastStreambuf
+//====================================================
+TEST_CASE( "Testing the FastStreambuf class." )
+ {
+  std::FILE* file = std::tmpfile();
+  REQUIRE( file != nullptr );
+  auto file_content = [ file ]()
+   {
+    std::string content( 64, '\0' );
+    std::rewind( file );
+    content.resize( std::fread( &content[0], 1, content.size(), file ) );
+    return content;
+   };
+
+  ptc::FastStreambuf buffer( fileno( file ), 16 );
+  std::ostream os( nullptr );
+  buffer.install( os );
+  CHECK_FALSE( buffer.isTTY() );
+  CHECK_EQ( os.rdbuf(), &buffer );
+
+  // Block buffering
+  ptc::print( os, "Fast", 1 );
+  CHECK_EQ( file_content(), "" );
+  os << std::flush;
+  CHECK_EQ( file_content(), "Fast 1\n" );
+
+  // Chunks larger than the buffer
+  os << "A line longer than the buffer.\n";
+  CHECK_EQ( file_content(), "Fast 1\nA line longer than the buffer.\n" );
+
+  // Line buffering
+  buffer.setLineBuffered( true );
+  os << 'x';
+  CHECK_EQ( file_content(), "Fast 1\nA line longer than the buffer.\n" );
+  os << '\n';
+  CHECK_EQ( file_content(), "Fast 1\nA line longer than the buffer.\nx\n" );
+
+  // Line buffering with a chunk which fills the buffer exactly, followed by a char
+  os << "01234567" << "89abcdef" << 'y';
+  CHECK_EQ( file_content(), "Fast 1\nA line longer than the buffer.\nx\n0123456789abcdef" );
+  os << '\n';
+  CHECK_EQ( file_content(), "Fast 1\nA line longer than the buffer.\nx\n0123456789abcdefy\n" );
+
+  buffer.uninstall();
+  CHECK_EQ( os.rdbuf(), nullptr );
+  std::fclose( file );
+ }
+
+TEST_CASE( "Testing the FastStreambuf writeGathered method." )
+ {
+  std::FILE* file = std::tmpfile();
+  REQUIRE( file != nullptr );
+  auto file_content = [ file ]()
+   {
+    std::string content( 1 << 18, '\0' );
+    std::rewind( file );
+    content.resize( std::fread( &content[0], 1, content.size(), file ) );
+    return content;
+   };
+
+  ptc::FastStreambuf buffer( fileno( file ) );
+  std::ostream os( &buffer );
+
+  // Pieces after pending output
+  os << "pending ";
+  const std::string_view pieces[] = { "first ", "", "second" };
+  CHECK( buffer.writeGathered( pieces, 3 ) );
+  CHECK_EQ( file_content(), "pending first second" );
+
+  // Lines with large strings
+  const std::string json( ptc::FastStreambuf::gather_threshold, '{' );
+  const std::string_view view( json.data(), json.size() / 2 + ptc::FastStreambuf::gather_threshold / 2 );
+  ptc::Print<char> printer;
+  printer.setPattern( "|" );
+  printer( os, "head", json, 3, view, "tail" );
+  CHECK_EQ( ptc::line_stream<char>().cuts.size(), 2 );
+  printer.setPattern( "" );
+  os << std::setw( 3 ) << std::left;
+  printer( os, json, "x" );
+  CHECK_EQ( ptc::line_stream<char>().cuts.size(), 0 );
+  os << std::flush;
+  std::string expected = "pending first second";
+  printer.setPattern( "|" );
+  expected += printer( ptc::mode::str, "head", json, 3, view, "tail" );
+  printer.setPattern( "" );
+  expected += printer( ptc::mode::str, json, "x" );
+  CHECK( file_content() == expected );
+
+  std::fclose( file );
+ }
+
+//====================================================
+//     shm_ring_sink
+//====================================================
+#if ! defined( _WIN32 )
+TEST_CASE( "Testing the shm_ring_sink class." )
+ {
+  const std::string name = "/ptc-unit-tests-" + std::to_string( ::getpid() );
+  ptc::shm_ring_sink sink( name, 256 );
+  ptc::shm_ring_reader reader( name );
+  std::string line;
+  CHECK_FALSE( reader.read( line ) );
+
+  // Lines
+  ptc::Print<char> printer;
+  printer( sink, "First", "line" );
+  sink << "partial " << 1;
+  sink << std::flush;
+  REQUIRE( reader.read( line ) );
+  CHECK_EQ( line, "First line\n" );
+  REQUIRE( reader.read( line ) );
+  CHECK_EQ( line, "partial 1" );
+  CHECK_FALSE( reader.read( line ) );
+
+  // Producers never block and count dropped lines
+  for( int i = 0; i < 20; ++i ) printer( sink, "Filling", "the", "ring", i );
+  CHECK( sink.dropped() > 0 );
+  CHECK_EQ( sink.written() + sink.dropped(), 22 );
+  std::uint64_t read = 2;
+  while( reader.read( line ) ) ++read;
+  CHECK_EQ( read, sink.written() );
+
+  // Wrapping around
+  for( int i = 0; i < 100; ++i )
+   {
+    printer( sink, "Wrapping", i );
+    REQUIRE( reader.read( line ) );
+    CHECK_EQ( line, "Wrapping " + std::to_string( i ) + "\n" );
+   }
+
+  // Multiple producers
+  const std::uint64_t before = sink.written();
+  std::thread producers[4];
+  for( int t = 0; t < 4; ++t ) producers[t] = std::thread( [ & ]{ ptc::shm_ring_sink other( name ); for( int i = 0; i < 50; ++i ) other << "Producer line\n"; } );
+  std::uint64_t consumed = 0;
+  for( auto& producer: producers ) 
+   {
+    while( producer.joinable() && reader.read( line ) ) { CHECK_EQ( line, "Producer line\n" ); ++consumed; }
+    producer.join();
+   }
+  while( reader.read( line ) ) { CHECK_EQ( line, "Producer line\n" ); ++consumed; }
+  CHECK_EQ( consumed, sink.written() - before );
+  CHECK( consumed > 0 );
+
+  sink.unlink();
+ }
+#endif
+
+
+//====================================================
+//     Input functions
+//====================================================
+TEST_CASE( "Testing the ptc::input and ptc::read_all functions." )
+ {
+  // Tokens conversion
+  CHECK_EQ( ptc::parse_token<int>( "-42" ), -42 );
+  CHECK_EQ( ptc::parse_token<unsigned>( "+42" ), 42u );
+  CHECK_EQ( ptc::parse_token<double>( "2.5e3" ), 2500.0 );
+  CHECK_EQ( ptc::parse_token<bool>( "True" ), true );
+  CHECK_EQ( ptc::parse_token<char>( "x" ), 'x' );
+  CHECK_EQ( ptc::parse_token<std::string>( "word" ), "word" );
+  CHECK_THROWS_AS( ptc::parse_token<int>( "12abc" ), std::invalid_argument );
+  CHECK_THROWS_AS( ptc::parse_token<int>( "+-1" ), std::invalid_argument );
+  CHECK_THROWS_AS( ptc::parse_token<char>( "xy" ), std::invalid_argument );
+  CHECK_THROWS_AS( ptc::parse_token<std::int8_t>( "300" ), std::out_of_range );
+
+  // Reading a file, with tokens across the buffer chunks
+  std::ofstream( "input.txt" ) << "12 -345\t6789\r\nword 1.5\n\n   +7 \nlast line\r\nend";
+   {
+    ptc::InputReader reader( std::string( "input.txt" ), 4 );
+    CHECK_EQ( reader.read<int>(), 12 );
+    CHECK_EQ( reader.read<long>(), -345 );
+    CHECK_EQ( reader.read<short>(), 6789 );
+    CHECK_EQ( reader.read<std::string>(), "word" );
+    CHECK_EQ( reader.read<float>(), 1.5f );
+    CHECK_EQ( reader.read<int>(), 7 );
+    reader.skipLineEnd();
+    std::string line;
+    CHECK( reader.readLine( line ) );
+    CHECK_EQ( line, "last line" );
+    CHECK( reader.readLine( line ) );
+    CHECK_EQ( line, "end" );
+    CHECK_FALSE( reader.readLine( line ) );
+    CHECK_THROWS_AS( reader.read<int>(), std::runtime_error );
+   }
+  CHECK_THROWS_AS( ptc::read_all<int>( "input.txt" ), std::invalid_argument );
+  CHECK_THROWS_AS( ptc::read_all<int>( "missing_input.txt" ), std::runtime_error );
+  std::ofstream( "input.txt" ) << "1 2\n3\n\n-4 5";
+  CHECK_EQ( ptc::read_all<int>( "input.txt" ), std::vector<int>( { 1, 2, 3, -4, 5 } ) );
+
+  // Reading the standard input
+  #if ! defined( _WIN32 )
+  std::ofstream( "input.txt" ) << "Alice\n3 4.5\n7\nrest of line\n";
+  const int saved = dup( 0 );
+  const int fd = open( "input.txt", O_RDONLY );
+  dup2( fd, 0 );
+  close( fd );
+  CHECK_EQ( ptc::input(), "Alice" );
+  const auto [ count, ratio ] = ptc::input<int, double>();
+  CHECK_EQ( count, 3 );
+  CHECK_EQ( ratio, 4.5 );
+  CHECK_EQ( ptc::input<int>(), 7 );
+  CHECK_EQ( ptc::input(), "rest of line" );
+  CHECK_THROWS_AS( ptc::input(), std::runtime_error );
+  dup2( saved, 0 );
+  close( saved );
+  #endif
+
+  std::remove( "input.txt" );
+ }
@@ -15,6 +15,8 @@
 #include <iostream>
 #include <streambuf>
 #include <string>
+#include <cstdio>
+#include <cstdlib>
 
 namespace ptc
  {
@@ -104,6 +106,29 @@ namespace ptc
     select_cout<T>::cout.rdbuf( buf );
     return sbuf.str();
    }
+
+  //====================================================
+  //     TempFile
+  //====================================================
+  struct TempFile
+   {
+    explicit TempFile( const std::string& name )
+     {
+      #if defined( _WIN32 )
+      const char* dir = std::getenv( "TEMP" );
+      #else
+      const char* dir = std::getenv( "TMPDIR" );
+      #endif
+      path = dir && *dir ? dir : "/tmp";
+      if ( path.back() != '/' && path.back() != '\\' ) path += '/';
+      path += name;
+      std::remove( path.c_str() );
+     }
+    ~TempFile() { std::remove( path.c_str() ); }
+    TempFile( const TempFile& ) = delete;
+    TempFile& operator=( const TempFile& ) = delete;
+    std::string path;
+   };
  }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+//====================================================
+//     File data
+//====================================================
+/**
+ * @file shm_tail.cpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Headers
+//====================================================
+
+// My headers
+#include <include/ptc/shm_ring_sink.hpp>
+
+// STD headers
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <atomic>
+#include <memory>
+
+//====================================================
+//     Global variables
+//====================================================
+static std::atomic<bool> running{ true };
+
+//====================================================
+//     Main
+//====================================================
+/**
+ * @brief Tail a ring written by ptc::shm_ring_sink objects to the terminal or to a file. Usage: shm_tail <name> [output file]. Dropped lines are reported on the standard error when their count changes.
+ *
+ */
+int main( int argc, char** argv )
+ {
+  if ( argc < 2 )
+   {
+    std::cerr << "Usage: " << argv[0] << " <name> [output file]\n";
+    return 1;
+   }
+  std::signal( SIGINT, []( int ){ running = false; } );
+  std::signal( SIGTERM, []( int ){ running = false; } );
+
+  // Waiting for a producer to create the ring
+  std::unique_ptr<ptc::shm_ring_reader> reader;
+  while( ! reader && running )
+   {
+    try { reader = std::make_unique<ptc::shm_ring_reader>( argv[1] ); }
+    catch( const std::exception& ) { std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) ); }
+   }
+  if ( ! reader ) return 0;
+
+  std::ofstream file;
+  if ( argc > 2 )
+   {
+    file.open( argv[2], std::ios::app );
+    if ( ! file )
+     {
+      std::cerr << "shm_tail: cannot open the output file \"" << argv[2] << "\"\n";
+      return 1;
+     }
+   }
+  std::ostream& out = argc > 2 ? file : std::cout;
+
+  // Consuming the lines
+  std::string line;
+  std::uint64_t dropped = reader -> dropped();
+  auto idle = std::chrono::microseconds( 50 );
+  while( running )
+   {
+    bool any = false;
+    while( reader -> read( line ) )
+     {
+      out.write( line.data(), static_cast<std::streamsize>( line.size() ) );
+      any = true;
+     }
+    if ( reader -> dropped() != dropped )
+     {
+      std::cerr << "shm_tail: " << reader -> dropped() - dropped << " lines dropped\n";
+      dropped = reader -> dropped();
+     }
+
+    // Backing off while the ring is empty
+    if ( any )
+     {
+      out.flush();
+      idle = std::chrono::microseconds( 50 );
+     }
+    else
+     {
+      std::this_thread::sleep_for( idle );
+      if ( idle < std::chrono::milliseconds( 10 ) ) idle *= 2;
+     }
+   }
+
+  // Draining the remaining lines
+  while( reader -> read( line ) ) out.write( line.data(), static_cast<std::streamsize>( line.size() ) );
+  out.flush();
+ }